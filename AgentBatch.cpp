@@ -0,0 +1,131 @@
+#include "AgentBatch.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// Planes each board character belongs to, as a bit mask over ObsPlane
+static const std::array<uint8_t, 256>& planeMasks() {
+    static const std::array<uint8_t, 256> masks = [] {
+        std::array<uint8_t, 256> m{};
+        auto set = [&m](char c, ObsPlane plane) { m[static_cast<unsigned char>(c)] |= 1 << plane; };
+
+        for (char c : { BOARD_WALL, WALL_VERT, WALL_HORIZ }) set(c, PLANE_WALLS);
+        set(BOARD_OBSTACLE, PLANE_OBSTACLES);
+        for (char c : { BOARD_KEY, BOARD_BOMB, BOARD_TORCH }) set(c, PLANE_ITEMS);
+        for (char c = DOOR_MIN_CHAR; c <= DOOR_MAX_CHAR; ++c) set(c, PLANE_FIXTURES);
+        for (char c : { BOARD_SWITCH_ON, BOARD_SWITCH_OFF, BOARD_SPRING, BOARD_RIDDLE, BOARD_TELEPORT })
+            set(c, PLANE_FIXTURES);
+        return m;
+    }();
+    return masks;
+}
+
+AgentBatch::AgentBatch(int count, const std::string& levels, uint64_t baseSeed)
+    : levelSet(levels), seed(baseSeed),
+      planes(static_cast<size_t>(count) * NUM_PLANES * PLANE_WORDS),
+      posX(count * NUM_PLAYERS), posY(count * NUM_PLAYERS),
+      rooms(count * NUM_PLAYERS), items(count * NUM_PLAYERS),
+      dead(count * NUM_PLAYERS), finished(count * NUM_PLAYERS),
+      lives(count * NUM_PLAYERS), scores(count * NUM_PLAYERS),
+      done(count), episodes(count), boardRoom(count, -1), boardRevision(count) {
+    for (int k = 0; k < count; ++k)
+        games.push_back(std::make_unique<AgentEnv>());
+}
+
+// Every game gets its own seed; later episodes of the same game continue the sequence
+bool AgentBatch::reset() {
+    for (int k = 0; k < size(); ++k) {
+        if (!games[k]->reset(levelSet, seed + k))
+            return false;
+        done[k] = 0;
+        episodes[k] = 0;
+        boardRoom[k] = -1;
+        observe(k);
+    }
+    return true;
+}
+
+void AgentBatch::stepAll(const int* actions) {
+    const uint64_t count = games.size();
+
+    for (int k = 0; k < size(); ++k) {
+        AgentEnv& g = *games[k];
+        if (done[k]) {                      // finished on the last step - start its next episode
+            g.reset(levelSet, seed + k + count * ++episodes[k]);
+            done[k] = 0;
+            boardRoom[k] = -1;          // the rooms were restored - revisions can repeat
+        }
+        g.act(actions[k * NUM_PLAYERS], actions[k * NUM_PLAYERS + 1]);
+        done[k] = g.last().done;
+        observe(k);
+    }
+}
+
+// Board planes of a room, one row word at a time - most cells are empty and cost one table lookup
+void AgentBatch::observeBoard(const Screen& room, uint64_t* base) {
+    const std::array<uint8_t, 256>& masks = planeMasks();
+
+    for (int y = 0; y < SCREEN_HEIGHT; ++y) {
+        for (int w = 0; w < PLANE_ROW_WORDS; ++w) {
+            uint64_t words[PLANE_PLAYERS] = {};
+            const int end = std::min(SCREEN_WIDTH, (w + 1) * 64);
+            for (int x = w * 64; x < end; ++x) {
+                const uint64_t mask = masks[static_cast<unsigned char>(room.charAt(Point(x, y)))];
+                if (!mask) continue;
+                const int shift = x % 64;
+                for (int plane = 0; plane < PLANE_PLAYERS; ++plane)
+                    words[plane] |= ((mask >> plane) & 1) << shift;
+            }
+            for (int plane = 0; plane < PLANE_PLAYERS; ++plane)
+                base[plane * PLANE_WORDS + y * PLANE_ROW_WORDS + w] = words[plane];
+        }
+    }
+}
+
+// Writes game k's planes and player fields into the shared arrays
+void AgentBatch::observe(int k) {
+    const AgentEnv& g = *games[k];
+    const Screen& room = g.currentRoom();
+
+    uint64_t* base = planes.data() + static_cast<size_t>(k) * NUM_PLANES * PLANE_WORDS;
+    std::memset(base + PLANE_PLAYERS * PLANE_WORDS, 0, sizeof(uint64_t) * PLANE_WORDS);
+
+    if (boardRoom[k] != g.getRoomOnScreen() || boardRevision[k] != room.getRevision()) {
+        observeBoard(room, base);
+        boardRoom[k] = g.getRoomOnScreen();
+        boardRevision[k] = room.getRevision();
+    }
+
+    // Light: everything, minus the cells of dark areas that no torch lights up
+    uint64_t* light = base + PLANE_LIGHT * PLANE_WORDS;
+    for (int y = 0; y < SCREEN_HEIGHT; ++y) {
+        for (int w = 0; w < PLANE_ROW_WORDS; ++w) {
+            int bits = std::min(64, SCREEN_WIDTH - w * 64);
+            light[y * PLANE_ROW_WORDS + w] = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        }
+    }
+    for (const DarkArea& area : room.getDarkAreas()) {
+        for (int y = std::max(area.topLeft.getY(), 0); y <= std::min(area.bottomRight.getY(), MAX_Y); ++y)
+            for (int x = std::max(area.topLeft.getX(), 0); x <= std::min(area.bottomRight.getX(), MAX_X); ++x)
+                if (!room.isIlluminated(Point(x, y)))
+                    light[y * PLANE_ROW_WORDS + x / 64] &= ~(uint64_t(1) << (x % 64));
+    }
+    uint64_t* playerPlane = base + PLANE_PLAYERS * PLANE_WORDS;
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        const Player& player = g.getPlayer(i);
+        const int slot = k * NUM_PLAYERS + i;
+        const Point& p = player.getPos();
+
+        posX[slot] = static_cast<int16_t>(p.getX());
+        posY[slot] = static_cast<int16_t>(p.getY());
+        rooms[slot] = static_cast<uint8_t>(g.getPlayerRoom(i));
+        items[slot] = player.checkItem();
+        dead[slot] = player.getDead();
+        finished[slot] = g.hasFinished(i);
+        lives[slot] = player.getLife();
+        scores[slot] = player.getScore();
+
+        if (rooms[slot] == g.getRoomOnScreen() && !dead[slot] && !finished[slot] && Point::checkLimits(p))
+            playerPlane[p.getY() * PLANE_ROW_WORDS + p.getX() / 64] |= uint64_t(1) << (p.getX() % 64);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "AgentEnv.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Observation bit-planes - one bit per board cell of the room on screen
+enum ObsPlane {          // board planes (taken from the cell characters) come first
+    PLANE_WALLS,        // W | =
+    PLANE_OBSTACLES,    // *
+    PLANE_ITEMS,        // collectibles: key, bomb, torch
+    PLANE_FIXTURES,     // doors, switches, springs, riddles, teleports
+    PLANE_PLAYERS,
+    PLANE_LIGHT,        // visible cells (outside dark areas, or lit by a torch)
+    NUM_PLANES
+};
+
+constexpr int PLANE_ROW_WORDS = (SCREEN_WIDTH + 63) / 64;        // 64-bit words per board row
+constexpr int PLANE_WORDS = PLANE_ROW_WORDS * SCREEN_HEIGHT;     // words per plane
+
+// K independent games stepped in lockstep with one call. Observations are written into shared
+// contiguous arrays: bit-planes laid out [game][plane][row][word], and the player fields as
+// one array per field, indexed [game * NUM_PLAYERS + player].
+// A game that ends stays readable until the next stepAll(), which resets it first.
+// Board planes are only rebuilt when the room on screen changed since the last step.
+// Only the observations are batched: each game is still its own AgentEnv with its own rooms and
+// objects, stepped one after the other, so a batch steps no faster than K separate AgentEnvs.
+class AgentBatch {
+private:
+    std::vector<std::unique_ptr<AgentEnv>> games;
+    std::string levelSet;
+    uint64_t seed;
+
+    std::vector<uint64_t> planes;
+    std::vector<int16_t> posX, posY;
+    std::vector<uint8_t> rooms, items, dead, finished;
+    std::vector<int32_t> lives, scores;
+    std::vector<uint8_t> done;          // [game] - the last step ended its episode
+    std::vector<uint32_t> episodes;     // [game] - episodes completed so far
+    std::vector<int> boardRoom;         // [game] - room and revision its board planes were taken from,
+    std::vector<uint64_t> boardRevision;    // -1 once a reset invalidated them
+
+    void observe(int k);
+    void observeBoard(const Screen& room, uint64_t* base);
+
+public:
+    AgentBatch(int count, const std::string& levels = "", uint64_t baseSeed = 0);
+
+    bool reset();                           // false if the level set can't be loaded
+    void stepAll(const int* actions);       // actions[game * NUM_PLAYERS + player], see AgentEnv
+
+    int size() const { return static_cast<int>(games.size()); }
+    const uint64_t* getPlanes() const { return planes.data(); }
+    const uint64_t* getPlane(int k, ObsPlane plane) const {
+        return planes.data() + (static_cast<size_t>(k) * NUM_PLANES + plane) * PLANE_WORDS;
+    }
+    static bool testBit(const uint64_t* plane, int x, int y) {
+        return (plane[y * PLANE_ROW_WORDS + x / 64] >> (x % 64)) & 1;
+    }
+
+    const int16_t* getPosX() const { return posX.data(); }
+    const int16_t* getPosY() const { return posY.data(); }
+    const uint8_t* getRooms() const { return rooms.data(); }
+    const uint8_t* getItems() const { return items.data(); }
+    const uint8_t* getDead() const { return dead.data(); }
+    const uint8_t* getFinished() const { return finished.data(); }
+    const int32_t* getLives() const { return lives.data(); }
+    const int32_t* getScores() const { return scores.data(); }
+    const uint8_t* getDone() const { return done.data(); }
+    uint32_t getEpisodes(int k) const { return episodes[k]; }
+    const std::vector<Results::Event>& getEvents(int k) const { return games[k]->last().events; }
+    const AgentEnv& game(int k) const { return *games[k]; }
+};
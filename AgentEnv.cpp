@@ -0,0 +1,104 @@
+#include "AgentEnv.h"
+#include <algorithm>
+
+bool AgentEnv::reset(const std::string& levelSet, uint64_t seed) {
+    if (hasInitial && levelSet == initialLevels) {
+        restore(initial);               // only the rooms the last episode touched are copied back
+    }
+    else {
+        setLevelDir(levelSet);
+        hasInitial = false;
+        if (!load()) return false;
+        initial = snapshot();
+        initialLevels = levelSet;
+        hasInitial = true;
+    }
+    setSeed(seed);
+
+    current.events.clear();
+    observe(current.observation);
+    current.done = gameOver;
+    return true;
+}
+
+void AgentEnv::act(int action1, int action2) {
+    const int actions[NUM_PLAYERS] = { action1, action2 };
+
+    keys.clear();
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        if (actions[i] >= RIGHT && actions[i] < NO_ACTION)
+            keys.push_back(players[i].getKey(static_cast<Direction>(actions[i])));
+    }
+
+    current.events.clear();
+    GameBase::step(keys);
+    current.done = gameOver;
+}
+
+bool AgentEnv::enterRoom(int roomID) {
+    Point start[NUM_PLAYERS];
+    for (int i = 0; i < NUM_PLAYERS; ++i)
+        start[i] = Point(PLAYER_START_X[i], PLAYER_START_Y[i]);
+    return enterRoom(roomID, start);
+}
+
+bool AgentEnv::enterRoom(int roomID, const Point start[NUM_PLAYERS]) {
+    if (roomID < ROOM1_SCREEN || roomID >= static_cast<int>(screens.size()) || isFinalRoom(roomID))
+        return false;
+
+    currRoomID = roomID;
+    gameCycles = 0;
+
+    Point placed[NUM_PLAYERS];
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        playerRoom[i] = roomID;
+        placed[i] = freeCellNear(start[i], placed, i);     // never on a player placed before
+        players[i].setStartPos(placed[i]);
+    }
+    return true;
+}
+
+Point AgentEnv::freeCellNear(const Point& wanted, const Point* taken, int numTaken) const {
+    const Screen& room = screens[currRoomID];
+    auto usable = [&](const Point& p) {
+        return std::find(taken, taken + numTaken, p) == taken + numTaken && !room.isLegendCell(p) && room.isCellFree(p);
+    };
+
+    if (Point::checkLimits(wanted) && usable(wanted)) return wanted;
+    for (int y = 1; y < SCREEN_HEIGHT; y++)         // same scan as GameBase::getStartPoint
+        for (int x = 1; x < SCREEN_WIDTH; x++)
+            if (usable(Point(x, y))) return Point(x, y);
+    return wanted;
+}
+
+const AgentStep& AgentEnv::step(int action1, int action2) {
+    act(action1, action2);
+    observe(current.observation);
+    return current;
+}
+
+void AgentEnv::observe(AgentObservation& obs) const {
+    obs.room = currRoomID;
+    obs.cycle = gameCycles;
+    obs.gameOver = gameOver;
+    screens[currRoomID].copyBoard(obs.cells);
+
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        const Player& player = players[i];
+        AgentPlayerView& view = obs.players[i];
+
+        view.x = static_cast<int16_t>(player.getPos().getX());
+        view.y = static_cast<int16_t>(player.getPos().getY());
+        view.room = static_cast<uint8_t>(playerRoom[i]);
+        view.dir = player.getDir();
+        view.item = player.checkItem();
+        view.dead = player.getDead();
+        view.finished = playerFinished[i];
+        view.lives = player.getLife();
+        view.score = player.getScore();
+
+        // Players aren't part of the board - draw the ones visible in this room
+        if (playerRoom[i] == currRoomID && !view.dead && !view.finished && Point::checkLimits(player.getPos()))
+            obs.cells[view.x][view.y] = player.getFigure();
+    }
+}
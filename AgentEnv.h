@@ -0,0 +1,91 @@
+#pragma once
+#include "HeadlessGame.h"
+#include "Results.h"
+#include <string>
+#include <vector>
+
+// Agent actions are the Directions RIGHT..DISPOSE (the player's six keys), or no key at all
+constexpr int NO_ACTION = DISPOSE + 1;
+constexpr int NUM_AGENT_ACTIONS = NO_ACTION + 1;
+
+// One player as an agent sees it: where it is, plus the values the legend shows
+struct AgentPlayerView {
+    int16_t x = 0, y = 0;
+    uint8_t room = 0;
+    uint8_t dir = STAY;         // Direction
+    uint8_t item = NONE;        // ItemType carried
+    bool dead = false;
+    bool finished = false;      // reached the final room
+    int lives = 0;
+    int score = 0;
+};
+
+struct AgentObservation {
+    int room = 0;                                   // room the cells belong to (the one on screen)
+    char cells[SCREEN_WIDTH][SCREEN_HEIGHT];        // [x][y] like Screen's board, players drawn in
+    AgentPlayerView players[NUM_PLAYERS];
+    size_t cycle = 0;
+    bool gameOver = false;
+};
+
+// What one step returns; events use the same records as a .results file
+struct AgentStep {
+    AgentObservation observation;
+    std::vector<Results::Event> events;     // only this step's events
+    bool done = false;
+};
+
+// In-process environment for scripted and learned agents: reset(), then one step() per cycle
+// with an action for each player. Runs the plain simulation core (no rendering, delays or prompts).
+// The loaded level set is kept as a snapshot, so resetting to it again doesn't touch the disk.
+class AgentEnv : public HeadlessGame {
+private:
+    AgentStep current;
+    std::vector<char> keys;         // reused key buffer for GameBase::step
+    GameSnapshot initial;           // level set right after loading
+    std::string initialLevels;
+    bool hasInitial = false;
+
+    void observe(AgentObservation& obs) const;
+    Point freeCellNear(const Point& wanted, const Point* taken, int numTaken) const;
+
+public:
+    explicit AgentEnv(bool solveRiddles = true) : HeadlessGame(solveRiddles) {}
+
+    using GameBase::step;
+    bool reset(const std::string& levelSet = "", uint64_t seed = 0);    // false if the level set can't be loaded
+    const AgentStep& step(int action1, int action2);
+    void act(int action1, int action2);     // step() without filling the observation (events and done still are)
+    const AgentStep& observeNow() {         // fills the observation after act()
+        observe(current.observation);
+        return current;
+    }
+
+    // Drops every player straight into a room, on the given cells (indexed by PlayerID) or the nearest
+    // free ones. False for the menu screen, the final room and rooms that don't exist.
+    bool enterRoom(int roomID, const Point start[NUM_PLAYERS]);
+    bool enterRoom(int roomID);     // on the cells a new game starts on (PLAYER_START_X/Y)
+    const AgentStep& last() const { return current; }
+
+    // Read access for batched observers (AgentBatch)
+    int getRoomOnScreen() const { return currRoomID; }
+    const Screen& currentRoom() const { return screens[currRoomID]; }
+    int getRoomCount() const { return static_cast<int>(screens.size()); }
+    const Player& getPlayer(int id) const { return players[id]; }
+    int getPlayerRoom(int id) const { return playerRoom[id]; }
+    bool hasFinished(int id) const { return playerFinished[id]; }
+
+    void onScreenChange(PlayerID id, int room) override {
+        current.events.push_back({ gameCycles, Results::SCREEN_CHANGE, id, room, 0, false });
+    }
+    void onLifeLost(PlayerID id) override {
+        current.events.push_back({ gameCycles, Results::LIFE_LOST, id, 0, 0, false });
+    }
+    void onRiddle(PlayerID id, bool correct) override {
+        current.events.push_back({ gameCycles, Results::RIDDLE_ANSWERED, id, 0, 0, correct });
+    }
+    void onGameEnd() override {
+        current.events.push_back({ gameCycles, Results::GAME_END, PLAYER_1,
+                                   players[PLAYER_1].getScore(), players[PLAYER_2].getScore(), false });
+    }
+};
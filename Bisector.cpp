@@ -0,0 +1,305 @@
+#include "Bisector.h"
+#include "Steps.h"
+#include "Results.h"
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#ifndef _WIN32
+#include <csignal>
+#include <cstdio>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+bool StateProbe::handleRiddles(Player& player, const Point& nextPos) {
+    if (!screens[currRoomID].getRiddleAt(nextPos)) return true;
+    bool answer = nextRiddle < riddleAnswers.size() ? riddleAnswers[nextRiddle++] : true;
+    return GameBase::handleRiddles(player, nextPos, answer);
+}
+
+bool StateProbe::open(const std::string& stepsFile, const std::string& resultsFile) {
+    for (const std::string& name : { stepsFile, resultsFile }) {
+        if (!std::ifstream(name).good()) return false;
+    }
+    if (!load()) return false;
+
+    Steps steps = Steps::loadSteps(stepsFile);
+    Results results = Results::loadResults(resultsFile);
+    setSeed(steps.getRandomSeed());
+
+    input.clear();
+    for (size_t t = 1; !steps.isEmpty(); ++t) {
+        input.emplace_back();
+        while (steps.isNextStepOnIteration(t))
+            input.back().push_back(steps.popStep());
+        steps.skipUntil(t);         // out-of-order lines are dropped, as FileGame would never reach them
+    }
+    if (input.size() < results.getLastCycle())     // a replay runs on until its last recorded event
+        input.resize(results.getLastCycle());
+
+    riddleAnswers.clear();
+    while (!results.hasNoMoreRiddles())
+        riddleAnswers.push_back(results.getNextRiddleResult());
+
+    nextRiddle = 0;
+    snapshots.clear();
+    snapshots[0] = { snapshot(), 0 };
+    return true;
+}
+
+void StateProbe::seek(size_t cycle) {
+    cycle = std::min(cycle, lastCycle());
+    auto from = std::prev(snapshots.upper_bound(cycle));
+    restore(from->second.first);
+    nextRiddle = from->second.second;
+
+    while (gameCycles < cycle && !isOver())
+        step(input[gameCycles]);
+    if (!snapshots.count(gameCycles))
+        snapshots[gameCycles] = { snapshot(), nextRiddle };
+}
+
+void StateProbe::serve(std::istream& in, std::ostream& out) {
+    std::string command;
+    size_t cycle = 0;
+    while (in >> command && command != "quit" && in >> cycle) {
+        seek(cycle);
+        if (command == "hash")
+            out << gameCycles << ' ' << stateHash() << '\n';
+        else {
+            dumpState(out);
+            out << "end\n";
+        }
+        out.flush();
+    }
+}
+
+namespace {
+
+// The other build's StateProbe, running as a child process and spoken to over its stdin/stdout
+class RemoteProbe {
+private:
+#ifndef _WIN32
+    FILE* toChild = nullptr;
+    FILE* fromChild = nullptr;
+    pid_t pid = -1;
+#endif
+
+    bool readLine(std::string& line) {
+#ifndef _WIN32
+        line.clear();
+        char buffer[256];
+        while (fgets(buffer, sizeof(buffer), fromChild)) {
+            line += buffer;
+            if (line.back() == '\n') {
+                line.pop_back();
+                return true;
+            }
+        }
+#endif
+        return false;
+    }
+
+    bool send(const std::string& command, size_t cycle) {
+#ifndef _WIN32
+        return fprintf(toChild, "%s %zu\n", command.c_str(), cycle) > 0 && fflush(toChild) == 0;
+#else
+        return false;
+#endif
+    }
+
+public:
+    bool start(const std::string& binary, const std::string& stepsFile, const std::string& resultsFile,
+               std::string& error) {
+#ifndef _WIN32
+        signal(SIGPIPE, SIG_IGN);       // a child that has gone away is a failed write, not the end of us
+        int down[2], up[2];
+        if (pipe(down) != 0 || pipe(up) != 0) {
+            error = "cannot create pipes";
+            return false;
+        }
+        pid = fork();
+        if (pid < 0) {
+            error = "cannot start " + binary;
+            return false;
+        }
+        if (pid == 0) {
+            signal(SIGPIPE, SIG_DFL);
+            dup2(down[0], STDIN_FILENO);
+            dup2(up[1], STDOUT_FILENO);
+            close(down[0]); close(down[1]); close(up[0]); close(up[1]);
+            execl(binary.c_str(), binary.c_str(), "-dumpstate", stepsFile.c_str(), resultsFile.c_str(), nullptr);
+            _exit(127);
+        }
+        close(down[0]);
+        close(up[1]);
+        toChild = fdopen(down[1], "w");
+        fromChild = fdopen(up[0], "r");
+        return toChild && fromChild;
+#else
+        error = "-bisect needs a POSIX system (the other build runs as a child process)";
+        return false;
+#endif
+    }
+
+    ~RemoteProbe() {
+#ifndef _WIN32
+        if (toChild) {
+            fputs("quit\n", toChild);
+            fclose(toChild);
+        }
+        if (fromChild) fclose(fromChild);
+        if (pid > 0) waitpid(pid, nullptr, 0);
+#endif
+    }
+
+    // Why the child stopped answering. Ends its input and reaps it: exit code 127 is the exec failing.
+    std::string whyStopped(const std::string& binary) {
+#ifndef _WIN32
+        if (toChild) {
+            fclose(toChild);
+            toChild = nullptr;
+        }
+        int status = 0;
+        if (pid > 0 && waitpid(pid, &status, 0) == pid) {
+            pid = -1;
+            if (WIFEXITED(status) && WEXITSTATUS(status) == 127) return "cannot run " + binary;
+        }
+#endif
+        return binary + " stopped answering (does it support -dumpstate?)";
+    }
+
+    bool hash(size_t cycle, size_t& reached, uint64_t& h) {
+        std::string line;
+        if (!send("hash", cycle) || !readLine(line)) return false;
+        std::istringstream fields(line);
+        return static_cast<bool>(fields >> reached >> h);
+    }
+
+    bool dump(size_t cycle, std::string& text) {
+        std::string line;
+        if (!send("dump", cycle)) return false;
+        text.clear();
+        while (readLine(line)) {
+            if (line == "end") return true;
+            text += line + '\n';
+        }
+        return false;
+    }
+};
+
+using Fields = std::vector<std::pair<std::string, std::string>>;     // name, value - in dump order
+
+Fields parseDump(const std::string& text) {
+    Fields fields;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t space = line.find(' ');
+        fields.emplace_back(line.substr(0, space), space == std::string::npos ? "" : line.substr(space + 1));
+    }
+    return fields;
+}
+
+const std::string* findField(const Fields& fields, const std::string& name) {
+    for (const auto& f : fields)
+        if (f.first == name) return &f.second;
+    return nullptr;
+}
+
+} // namespace
+
+// Board rows are compared cell by cell, object lines field=value by field=value
+void Bisector::printDiff(const std::string& ours, const std::string& theirs, std::ostream& out) {
+    const Fields a = parseDump(ours), b = parseDump(theirs);
+
+    for (const auto& field : a) {
+        const std::string* other = findField(b, field.first);
+        if (!other) {
+            out << "  " << field.first << ": " << field.second << " (only in this build)\n";
+            continue;
+        }
+        if (*other == field.second) continue;
+
+        size_t row = field.first.find(".row");
+        if (row != std::string::npos) {
+            const std::string room = field.first.substr(0, row);
+            const int y = std::stoi(field.first.substr(row + 4));
+            for (size_t x = 0; x < std::min(field.second.size(), other->size()); ++x) {
+                if (field.second[x] != (*other)[x])
+                    out << "  " << room << " cell (" << x << "," << y << "): '" << field.second[x]
+                        << "' vs '" << (*other)[x] << "'\n";
+            }
+            continue;
+        }
+
+        std::istringstream mine(field.second), theirsIn(*other);
+        std::string x, y;
+        bool split = field.second.find('=') != std::string::npos;
+        while (split && mine >> x && theirsIn >> y) {
+            if (x != y) out << "  " << field.first << ' ' << x << " vs " << y.substr(y.find('=') + 1) << '\n';
+        }
+        if (!split)
+            out << "  " << field.first << ": " << field.second << " vs " << *other << '\n';
+    }
+    for (const auto& field : b) {
+        if (!findField(a, field.first))
+            out << "  " << field.first << ": " << field.second << " (only in the other build)\n";
+    }
+}
+
+int Bisector::run(const std::string& otherBinary, const std::string& stepsFile, const std::string& resultsFile,
+                  std::ostream& out) {
+    StateProbe ours;
+    if (!ours.open(stepsFile, resultsFile)) {
+        out << "bisect: cannot read " << stepsFile << " / " << resultsFile << " or the level files\n";
+        return 2;
+    }
+    RemoteProbe theirs;
+    std::string error;
+    if (!theirs.start(otherBinary, stepsFile, resultsFile, error)) {
+        out << "bisect: " << error << "\n";
+        return 2;
+    }
+
+    int probes = 0;
+    bool failed = false;
+    auto differs = [&](size_t cycle) {
+        size_t reached = 0;
+        uint64_t h = 0;
+        probes++;
+        ours.seek(cycle);
+        if (!theirs.hash(cycle, reached, h)) failed = true;
+        return failed || h != ours.stateHash() || reached != ours.getCycle();
+    };
+
+    size_t first = 0;
+    if (!differs(0)) {
+        size_t lo = 0, hi = ours.lastCycle();       // the states agree at lo and differ at hi
+        if (!differs(hi) && !failed) {
+            out << "No divergence: both builds agree at cycle " << hi << " (" << probes << " probes)\n";
+            return 0;
+        }
+        while (hi - lo > 1 && !failed) {
+            size_t mid = lo + (hi - lo) / 2;
+            (differs(mid) ? hi : lo) = mid;
+        }
+        first = hi;
+    }
+
+    std::string theirState;
+    if (failed || !theirs.dump(first, theirState)) {
+        out << "bisect: " << theirs.whyStopped(otherBinary) << '\n';
+        return 2;
+    }
+    ours.seek(first);
+    std::ostringstream ourState;
+    ours.dumpState(ourState);
+
+    out << "First divergent cycle: " << first << " (" << probes << " probes)\n"
+        << "Differences (this build vs " << otherBinary << "):\n";
+    printDiff(ourState.str(), theirState, out);
+    return 1;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "HeadlessGame.h"
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Replays a recording on the headless core and answers "what is the state at cycle C" for any C,
+// in any order. Every state asked for is kept as a snapshot, so later questions only simulate from
+// the nearest earlier one. Riddles get the answers recorded in the results file.
+class StateProbe : public HeadlessGame {
+private:
+    std::vector<std::vector<char>> input;      // keys of each cycle (index 0 = cycle 1)
+    std::vector<bool> riddleAnswers;
+    size_t nextRiddle = 0;
+    std::map<size_t, std::pair<GameSnapshot, size_t>> snapshots;     // cycle -> state, riddles answered
+
+protected:
+    bool handleRiddles(Player& player, const Point& nextPos) override;
+
+public:
+    StateProbe() : HeadlessGame(true) {}
+
+    bool open(const std::string& stepsFile, const std::string& resultsFile);   // false if a file can't be read
+    size_t lastCycle() const { return input.size(); }
+    void seek(size_t cycle);            // stops early if the game ends first
+
+    // The -dumpstate side of -bisect: answers "hash C" and "dump C" lines until "quit" or end of input
+    void serve(std::istream& in, std::ostream& out);
+};
+
+// Finds the first cycle where two builds disagree on a recording. The other build runs as a child
+// process (<binary> -dumpstate <steps> <results>); both sides compare stateHash by binary search
+// over the cycles, then the two states at the first divergent cycle are diffed field by field
+// (board rows cell by cell).
+// Assumes that once the states differ they stay different.
+class Bisector {
+public:
+    static int run(const std::string& otherBinary, const std::string& stepsFile, const std::string& resultsFile,
+                   std::ostream& out);     // 0 - the builds agree
+    static void printDiff(const std::string& ours, const std::string& theirs, std::ostream& out);
+};
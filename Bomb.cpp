@@ -4,7 +4,7 @@
 // The bomb becomes active and ticking immediately.
 void Bomb::arm(const Point& p) {
     pos = p;
-    timer = 5;     
+    timer = BOMB_TIMER;
     active = ticking = true;
 }
 
@@ -18,29 +18,3 @@ bool Bomb::tick() {
     }
     return false;          
 }
-
-std::vector<std::vector<Point>> Bomb::getBlastPattern(Point center, int radius) {
-    std::vector<std::vector<Point>> allRays;
-    allRays.reserve(9); // saving place in advance for all rays
-
-    std::vector<Point> centerPoint;
-    centerPoint.emplace_back(center);
-    allRays.push_back(std::move(centerPoint)); // center point
-
-    int directions[8][2] = {
-        {0, -1}, {0, 1}, {-1, 0}, {1, 0},
-        {-1, -1}, {1, -1}, {-1, 1}, {1, 1}
-    };
-
-    for (auto& dir : directions) {
-        std::vector<Point> currentRay;
-        currentRay.reserve(radius); // saving place in advance for the exact number of points in each ray
-        for (int i = 1; i <= radius; i++) {
-            int pX = center.getX() + (dir[0] * i);
-            int pY = center.getY() + (dir[1] * i);
-            currentRay.emplace_back(pX, pY);
-        }
-        allRays.push_back(std::move(currentRay)); // move ctr instead of deep copy
-    }
-    return allRays;
-}
\ No newline at end of file
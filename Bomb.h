@@ -1,35 +1,103 @@
 #pragma once
 #include "Point.h"
-#include <vector>
+#include "Zobrist.h"
+#include "Utils.h"
+#include <bitset>
 
 class Bomb {
 private:
     Point pos;               // Position of the bomb of the board
-    char figure = '@'; 
-    int timer = 5;           // Countdown until explosion
-    bool active;             // True if the bomb exists on the board
-    bool ticking = false;    // True if the timer is currently decreasing
+    int8_t timer;            // Countdown until explosion
+    uint8_t active  : 1;     // True if the bomb exists on the board
+    uint8_t ticking : 1;     // True if the timer is currently decreasing
+    uint8_t spare   : 6;     // Unused, always 0 - every bit of the record is defined (raw state files)
+    uint16_t id;             // Stable within the room's bomb list - what a player holding it remembers
 
 public:
-    Bomb() : pos(0, 0), figure('@'), timer(5), active(false), ticking(false)   // default ctor 
+    Bomb() : pos(0, 0), timer(BOMB_TIMER), active(false), ticking(false), spare(0), id(0)   // default ctor 
     {
     }
     explicit Bomb(Point _pos)                    // custom ctor     
-        : pos(_pos), timer(5), active(true), ticking(false)
+        : pos(_pos), timer(BOMB_TIMER), active(true), ticking(false), spare(0), id(0)
     {
     }    
 
     // Get / Set Functions
     void setPos(const Point& p) { pos = p; }
     Point getPos() const { return pos; }
-    char getFigure() const { return figure; }
+    char getFigure() const { return BOARD_BOMB; }
+    uint64_t hashKey() const {   // Zobrist key of this record (position, timer and flags)
+        return Zobrist::key(Zobrist::BOMB, Zobrist::pack(pos), static_cast<uint8_t>(timer) | (active << 8) | (ticking << 9));
+    }
 
     void activate() { active = true; }
     void deactivate() { active = false; }
     bool isActive() const { return active; }
+    int getId() const { return id; }
+    void setId(int _id) { id = static_cast<uint16_t>(_id); }
     bool isTicking() const { return ticking; }
+    int getTimer() const { return timer; }
     void setTicking() { ticking = true; }
     void arm(const Point& p);
     bool tick();
-    static std::vector<std::vector<Point>> getBlastPattern(Point center, int radius);
+};
+
+// Compile-time blast pattern: for each of the 8 rays (4 straight, 4 diagonal),
+// the (dx, dy) offsets from the bomb's center, ordered from the center outwards.
+template <int RADIUS>
+struct BlastTable {
+    static constexpr int NUM_RAYS = 8;
+    int8_t dx[NUM_RAYS][RADIUS];
+    int8_t dy[NUM_RAYS][RADIUS];
+
+    constexpr BlastTable() : dx(), dy() {
+        const int rayDir[NUM_RAYS][2] = {
+            {0, -1}, {0, 1}, {-1, 0}, {1, 0},
+            {-1, -1}, {1, -1}, {-1, 1}, {1, 1}
+        };
+        for (int r = 0; r < NUM_RAYS; r++) {
+            for (int i = 0; i < RADIUS; i++) {
+                dx[r][i] = static_cast<int8_t>(rayDir[r][0] * (i + 1));
+                dy[r][i] = static_cast<int8_t>(rayDir[r][1] * (i + 1));
+            }
+        }
+    }
+};
+
+template <int RADIUS>
+constexpr BlastTable<RADIUS> blastTable{};
+
+// Explosions in progress during one tick's chain reactions, innermost on top. A blast that reaches
+// another bomb suspends its ray until that bomb's own blast is done, as a recursive resolver would.
+// Fixed capacity (one slot per board cell) and a mask of the bombs that went off, so every bomb
+// explodes exactly once per tick and no heap memory is needed.
+class BlastStack {
+public:
+    struct Frame {
+        Point center;
+        int8_t ray;         // ray being blasted (NUM_RAYS - all done)
+        int8_t cell;        // index of the next cell along it
+        bool resume;        // the cell waits on a chained bomb - blast it without looking again
+    };
+
+private:
+    Frame frames[BOARD_CELLS];
+    std::bitset<BOARD_CELLS> exploded;
+    int size = 0;
+
+public:
+    bool push(const Point& p) {   // returns false if this bomb already went off this tick
+        int cell = p.getY() * SCREEN_WIDTH + p.getX();
+        if (exploded[cell]) return false;
+        exploded[cell] = true;
+        frames[size++] = { p, 0, 0, false };
+        return true;
+    }
+    Frame& top() { return frames[size - 1]; }
+    void pop() { size--; }
+    bool empty() const { return size == 0; }
+    void clear() {
+        exploded.reset();
+        size = 0;
+    }
 };
@@ -0,0 +1,238 @@
+#include "ControlServer.h"
+#include <cstring>
+#include <type_traits>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+template <typename T>
+void put(std::string& out, T value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values are sent raw");
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool take(const std::string& in, size_t& at, T& value) {
+    if (at + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + at, sizeof(T));
+    at += sizeof(T);
+    return true;
+}
+
+bool readExact(FILE* in, void* to, size_t size) {
+    return size == 0 || std::fread(to, 1, size, in) == size;
+}
+
+} // namespace
+
+void ControlServer::error(const std::string& message) {
+    reply.clear();
+    put(reply, uint32_t(0));
+    put(reply, uint8_t(CONTROL_ERROR));
+    put(reply, static_cast<uint32_t>(message.size()));
+    reply += message;
+}
+
+void ControlServer::addEvents(const AgentStep& step, uint32_t& count) {
+    for (const Results::Event& e : step.events) {
+        put(reply, static_cast<uint64_t>(e.cycle));
+        put(reply, static_cast<uint8_t>(e.type));
+        put(reply, static_cast<uint8_t>(e.player));
+        put(reply, static_cast<int32_t>(e.data1));
+        put(reply, static_cast<int32_t>(e.data2));
+        put(reply, static_cast<uint8_t>(e.correct));
+        count++;
+    }
+}
+
+void ControlServer::addObservation(const AgentStep& step) {
+    const AgentObservation& obs = step.observation;
+    const Screen& room = env.currentRoom();
+    const bool board = obs.room != sentRoom || room.getStateHash() != sentHash;
+
+    put(reply, static_cast<uint64_t>(obs.cycle));
+    put(reply, static_cast<uint8_t>(obs.room));
+    put(reply, static_cast<uint8_t>((obs.gameOver ? OBSERVATION_GAME_OVER : 0) | (board ? OBSERVATION_BOARD : 0)));
+    for (const AgentPlayerView& p : obs.players) {
+        put(reply, p.x);
+        put(reply, p.y);
+        put(reply, p.room);
+        put(reply, p.dir);
+        put(reply, p.item);
+        put(reply, static_cast<uint8_t>(p.dead | (p.finished << 1)));
+        put(reply, static_cast<int32_t>(p.lives));
+        put(reply, static_cast<int32_t>(p.score));
+    }
+    if (!board) return;
+
+    char cells[SCREEN_WIDTH][SCREEN_HEIGHT];        // the room without the players drawn in
+    room.copyBoard(cells);
+    for (int y = 0; y < SCREEN_HEIGHT; ++y)
+        for (int x = 0; x < SCREEN_WIDTH; ++x) reply += cells[x][y];
+    sentRoom = obs.room;
+    sentHash = room.getStateHash();
+}
+
+bool ControlServer::handle(uint8_t type, const std::string& payload) {
+    size_t at = 0;
+    reply.clear();
+    put(reply, uint32_t(0));        // length, filled in by serve()
+    put(reply, uint8_t(CONTROL_RESULT));
+
+    if (type == CONTROL_RESET) {
+        uint64_t seed = 0;
+        uint32_t length = 0;
+        if (!take(payload, at, seed) || !take(payload, at, length) || at + length != payload.size()) {
+            error("bad RESET");
+            return false;
+        }
+        if (!env.reset(payload.substr(at), seed)) {
+            ready = false;
+            error("cannot load the level files: " + env.getLastError());
+            return false;
+        }
+        ready = true;
+        sentRoom = -1;
+        put(reply, uint16_t(0));
+        put(reply, uint32_t(0));
+        put(reply, uint16_t(1));
+        addObservation(env.last());
+        return true;
+    }
+
+    if (type != CONTROL_STEP) {
+        error("unknown message " + std::to_string(type));
+        return false;
+    }
+    uint8_t flags = 0;
+    uint16_t ticks = 0;
+    if (!take(payload, at, flags) || !take(payload, at, ticks) || payload.size() - at != 2u * ticks) {
+        error("bad STEP");
+        return false;
+    }
+    if (!ready) {
+        error("STEP before RESET");
+        return false;
+    }
+
+    // Events go out first, but are only known as the ticks run - observations wait in their own buffer
+    const bool every = (flags & STEP_OBSERVE_EVERY) != 0;
+    std::string observations;
+    uint16_t ran = 0, observed = 0;
+    uint32_t events = 0;
+    const size_t eventsAt = reply.size() + sizeof(uint16_t);
+    put(reply, uint16_t(0));
+    put(reply, uint32_t(0));
+
+    while (ran < ticks && !env.last().done) {
+        const uint8_t action1 = payload[at++], action2 = payload[at++];
+        env.act(action1, action2);
+        ran++;
+        addEvents(env.last(), events);
+
+        if (every || ran == ticks || env.last().done) {
+            std::swap(reply, observations);
+            addObservation(env.observeNow());
+            std::swap(reply, observations);
+            observed++;
+        }
+    }
+    if (observed == 0) {            // nothing ran: the game was already over
+        std::swap(reply, observations);
+        addObservation(env.observeNow());
+        std::swap(reply, observations);
+        observed++;
+    }
+
+    std::memcpy(&reply[eventsAt - sizeof(uint16_t)], &ran, sizeof(ran));
+    std::memcpy(&reply[eventsAt], &events, sizeof(events));
+    put(reply, observed);
+    reply += observations;
+    return true;
+}
+
+bool ControlServer::serve(FILE* in, FILE* out) {
+    std::string payload;
+    uint32_t length = 0;
+    uint8_t type = 0;
+
+    while (readExact(in, &length, sizeof(length))) {
+        if (length == 0 || length > CONTROL_MAX_FRAME || !readExact(in, &type, sizeof(type)))
+            return false;
+        payload.resize(length - 1);
+        if (!readExact(in, &payload[0], payload.size())) return false;
+        if (type == CONTROL_QUIT) return true;
+
+        handle(type, payload);
+        const uint32_t replyLength = static_cast<uint32_t>(reply.size() - sizeof(uint32_t));
+        std::memcpy(&reply[0], &replyLength, sizeof(replyLength));
+        if (std::fwrite(reply.data(), 1, reply.size(), out) != reply.size() || std::fflush(out) != 0)
+            return false;       // the client went away (EPIPE) - no reply can reach it
+    }
+    return false;
+}
+
+int ControlServer::run(const std::string& socketPath) {
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN);       // a client that disconnects mid-reply is an EPIPE write error, not the end of us
+#endif
+    ControlServer server;
+    if (socketPath.empty()) {
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        server.serve(stdin, stdout);
+        return 0;
+    }
+
+#ifndef _WIN32
+    sockaddr_un address {};
+    if (socketPath.size() >= sizeof(address.sun_path)) return 2;
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    // A socket left behind by an earlier run is replaced - anything else at that path is not ours to delete
+    struct stat existing;
+    if (lstat(socketPath.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            std::fprintf(stderr, "%s exists and is not a socket\n", socketPath.c_str());
+            return 2;
+        }
+        unlink(socketPath.c_str());
+    }
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 1) != 0) {
+        if (listener >= 0) close(listener);
+        return 2;
+    }
+
+    bool quit = false;
+    while (!quit) {
+        const int client = accept(listener, nullptr, nullptr);
+        if (client < 0) break;
+        FILE* in = fdopen(client, "rb");
+        FILE* out = in ? fdopen(dup(client), "wb") : nullptr;
+        if (in && out) quit = server.serve(in, out);
+        if (out) std::fclose(out);
+        if (in) std::fclose(in);
+        else close(client);
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+    return 0;
+#else
+    return 2;       // no Unix sockets - use stdin/stdout
+#endif
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "AgentEnv.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// File: ControlServer.h
+// Description:
+//   Binary control protocol for agents and tools in other processes (-control [socket]).
+//   The engine runs an AgentEnv and is driven over stdin/stdout or a Unix socket by framed messages:
+//     frame    = u32 length of the rest, u8 type, payload      (host byte order, like StateIO)
+//   Requests:
+//     RESET    = u64 seed, u32 length, level set directory ("" - working directory)
+//     STEP     = u8 flags, u16 ticks, ticks x (u8 action1, u8 action2)   actions as in AgentEnv
+//     QUIT     = nothing
+//   Replies (one per RESET / STEP):
+//     RESULT   = u16 ticks run, u32 events, events x EVENT, u16 observations, observations x OBSERVATION
+//     ERROR    = u32 length, message
+//     EVENT    = u64 cycle, u8 type, u8 player, i32 data1, i32 data2, u8 correct   (Results::Event)
+//     OBSERVATION = u64 cycle, u8 room, u8 flags, 2 x PLAYER, [SCREEN_HEIGHT x SCREEN_WIDTH board bytes, by rows]
+//     PLAYER   = i16 x, i16 y, u8 room, u8 dir, u8 item, u8 flags (dead, finished), i32 lives, i32 score
+//   A STEP runs its ticks back to back and stops early when the game ends. It observes only the
+//   last tick, unless STEP_OBSERVE_EVERY is set. The board (without players) is sent only when the
+//   room on screen or its contents changed since the last one sent.
+
+enum ControlMessage : uint8_t {
+    CONTROL_RESET = 1, CONTROL_STEP = 2, CONTROL_QUIT = 3,
+    CONTROL_RESULT = 0x81, CONTROL_ERROR = 0xFF
+};
+
+constexpr uint8_t STEP_OBSERVE_EVERY = 1;           // STEP flag: one observation per tick
+constexpr uint8_t OBSERVATION_GAME_OVER = 1;        // OBSERVATION flags
+constexpr uint8_t OBSERVATION_BOARD = 2;
+constexpr uint32_t CONTROL_MAX_FRAME = 1 << 20;     // longer requests are refused
+
+class ControlServer {
+private:
+    AgentEnv env;
+    bool ready = false;             // a RESET succeeded
+    int sentRoom = -1;              // room and room hash of the last board sent
+    uint64_t sentHash = 0;
+    std::string reply;              // reused reply buffer
+
+    void addObservation(const AgentStep& step);
+    void addEvents(const AgentStep& step, uint32_t& count);
+    bool handle(uint8_t type, const std::string& payload);      // false - a protocol error was replied
+    void error(const std::string& message);
+
+public:
+    ControlServer() : env(true) {}
+
+    bool serve(FILE* in, FILE* out);        // until QUIT (true), or end of input or a failed reply (false)
+
+    // stdin/stdout, or a Unix socket that takes one client at a time until one sends QUIT
+    static int run(const std::string& socketPath);
+};
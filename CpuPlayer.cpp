@@ -0,0 +1,151 @@
+#include "CpuPlayer.h"
+#include <utility>
+
+// Cells the computer player walks over. Doors are only ever walked into, as targets; riddles are
+// avoided unless the game answers them, so it never stops to ask the computer a question.
+static bool isWalkable(const Screen& room, const Point& p, bool throughRiddles) {
+    const char c = room.charAt(p);
+    if (room.isWall(p) || room.isLegendCell(p)) return false;
+    if (c >= DOOR_MIN_CHAR && c <= DOOR_MAX_CHAR) return false;
+    return c != BOARD_OBSTACLE && (c != BOARD_RIDDLE || throughRiddles);
+}
+
+// Brings passability and the target list in line with the room, a row at a time until the deadline.
+// A scan that runs out of time carries on from the same cell next cycle.
+void CpuPlayer::sync(const Screen& room, int id, Clock::time_point deadline) {
+    if (id != roomID) {                 // new room - none of the fields apply
+        targets.clear();
+        lastSwitch = Point(-1, -1);
+        roomID = id;
+        scanCell = BOARD_CELLS;
+    }
+    else if (scanCell == BOARD_CELLS && room.getStateHash() == roomHash)
+        return;
+
+    if (scanCell == BOARD_CELLS) {
+        scanCell = 0;
+        scanHash = room.getStateHash();
+        opened.clear();
+        blocked.clear();
+        found.clear();
+    }
+
+    for (const int first = scanCell; scanCell < BOARD_CELLS; ++scanCell) {
+        if (scanCell % SCREEN_WIDTH == 0 && scanCell > first && Clock::now() >= deadline)
+            return;     // at least a row per cycle
+
+        const Point p(scanCell % SCREEN_WIDTH, scanCell / SCREEN_WIDTH);
+        const uint8_t walkable = isWalkable(room, p, throughRiddles);
+        if (walkable != passable[scanCell]) {
+            (walkable ? opened : blocked).push_back(scanCell);
+            passable[scanCell] = walkable;
+        }
+
+        const char c = room.charAt(p);
+        if (c >= DOOR_MIN_CHAR && c <= DOOR_MAX_CHAR) found.push_back({ TARGET_DOOR, p });
+        else if (c == BOARD_KEY) found.push_back({ TARGET_KEY, p });
+        else if (c == BOARD_SWITCH_ON || c == BOARD_SWITCH_OFF) found.push_back({ TARGET_SWITCH, p });
+    }
+    applyScan();
+    roomHash = scanHash;        // if the board changed mid-scan, the next cycle scans again
+}
+
+// Targets that are still there keep their fields and only get the flipped cells repaired (the repair
+// itself runs in DistanceField::work); new targets start a fresh field
+void CpuPlayer::applyScan() {
+    for (size_t i = 0; i < targets.size(); ++i)
+        targetAt[targets[i].pos.getY() * SCREEN_WIDTH + targets[i].pos.getX()] = static_cast<int16_t>(i);
+
+    std::vector<Target> next;
+    next.reserve(found.size());
+    for (const auto& f : found) {
+        const int cell = f.second.getY() * SCREEN_WIDTH + f.second.getX();
+        const int same = targetAt[cell];
+        if (same >= 0 && targets[same].kind == f.first) {
+            next.push_back(std::move(targets[same]));
+            if (!opened.empty() || !blocked.empty()) next.back().field.update(opened, blocked);
+        }
+        else {
+            next.push_back({ f.first, f.second, DistanceField() });
+            next.back().field.build({ f.second });
+        }
+    }
+    for (const Target& t : targets)
+        targetAt[t.pos.getY() * SCREEN_WIDTH + t.pos.getX()] = -1;
+    targets = std::move(next);
+}
+
+// Nearest target worth walking to, among the fields that are up to date
+const CpuPlayer::Target* CpuPlayer::choose(const Screen& room, const Player& self) const {
+    const Point& pos = self.getPos();
+    const std::vector<Door>& doors = room.getDoors();
+    const Target* best = nullptr;
+    uint16_t bestDist = UNREACHABLE;
+
+    auto consider = [&](const Target& t) {
+        const uint16_t d = t.field.at(pos);
+        if (t.field.isReady() && d < bestDist) {
+            best = &t;
+            bestDist = d;
+        }
+    };
+    auto holdsKeyFor = [&room, &self](const Door& door) {
+        const Key* k = self.checkItem() == KEY ? room.getStoredKey(self.getItemId()) : nullptr;
+        return k && k->getDoorID() == door.getDoorID();
+    };
+    auto doorAt = [&doors](const Point& p) -> const Door* {
+        for (const Door& d : doors)
+            if (d.getPos() == p) return &d;
+        return nullptr;
+    };
+
+    if (self.inventoryEmpty()) {
+        for (const Target& t : targets)
+            if (t.kind == TARGET_KEY) consider(t);
+        if (best) return best;
+    }
+
+    bool waitingOnSwitches = false;
+    for (const Target& t : targets) {
+        if (t.kind != TARGET_DOOR) continue;
+        const Door* door = doorAt(t.pos);
+        if (!door) continue;
+        if (!door->getSwitchStatus()) waitingOnSwitches = true;
+        if (door->checkIsOpen() || (door->getSwitchStatus() && (door->getKeyStatus() || holdsKeyFor(*door))))
+            consider(t);
+    }
+    if (best || !waitingOnSwitches) return best;
+
+    for (const Target& t : targets)
+        if (t.kind == TARGET_SWITCH && t.pos != lastSwitch) consider(t);
+    return best;
+}
+
+Direction CpuPlayer::think(const Screen& room, int id, const Player& self, int budgetMicros) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budgetMicros);
+
+    sync(room, id, deadline);
+    for (Target& t : targets)
+        if (!t.field.isReady() && !t.field.work(passable.data(), deadline)) break;
+
+    const Point& pos = self.getPos();
+    if (room.isSwitch(pos)) lastSwitch = pos;
+
+    Direction dir = STAY;
+    if (const Target* goal = choose(room, self)) {
+        // Downhill on the goal's field, keeping the current direction when it is as good as any
+        uint16_t bestDist = goal->field.at(pos);
+        if (self.getDir() < STAY && goal->field.at(pos.next(self.getDir())) < bestDist)
+            dir = self.getDir();
+        else {
+            for (Direction d : { RIGHT, DOWN, LEFT, UP }) {
+                const uint16_t next = goal->field.at(pos.next(d));
+                if (next < bestDist) {
+                    bestDist = next;
+                    dir = d;
+                }
+            }
+        }
+    }
+    return dir;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "DistanceField.h"
+#include "Player.h"
+#include "Screen.h"
+#include <vector>
+
+constexpr int CPU_TICK_BUDGET_US = 1000;    // thinking time the computer player gets per cycle
+
+// Computer-controlled player. Keeps a distance field to every door, key and switch of its room
+// and walks downhill on the one it wants: a key while its hands are empty, then a door it can
+// get through, or a switch while a door still waits on its switches.
+// Fields are rebuilt only when the room changes; after that, board cells whose passability flips
+// (pushed obstacles, bomb blasts, toggled switches and opened doors) are repaired in place.
+// All the work - the board scan that finds those cells, matching targets and the field repairs -
+// stops at the per-cycle deadline and carries on next cycle. Until a scan is done the last finished
+// one is used, and a field that isn't up to date yet is simply not used for that cycle's decision.
+class CpuPlayer {
+private:
+    enum TargetKind : uint8_t { TARGET_DOOR, TARGET_KEY, TARGET_SWITCH };
+
+    struct Target {
+        TargetKind kind;
+        Point pos;
+        DistanceField field;
+    };
+
+    bool throughRiddles;                // the game answers riddles for this player, so they are walkable
+    using Clock = std::chrono::steady_clock;
+
+    int roomID = -1;
+    uint64_t roomHash = 0;              // Screen::getStateHash of the room the fields match
+    std::vector<uint8_t> passable;      // [y * SCREEN_WIDTH + x]
+    std::vector<Target> targets;
+    Point lastSwitch{ -1, -1 };         // switch toggled last - not walked back to right away
+
+    // Board scan in progress (scanCell < BOARD_CELLS), resumed every cycle until it reaches the end
+    int scanCell = BOARD_CELLS;
+    uint64_t scanHash = 0;              // room hash when the scan started
+    std::vector<int> opened, blocked;   // cells whose passability flipped so far
+    std::vector<std::pair<TargetKind, Point>> found;
+    std::vector<int16_t> targetAt;      // [cell] index into targets, -1 for none (matching scratch)
+
+    void sync(const Screen& room, int id, Clock::time_point deadline);
+    void applyScan();
+    const Target* choose(const Screen& room, const Player& self) const;
+
+public:
+    explicit CpuPlayer(bool answeredRiddles = false)
+        : throughRiddles(answeredRiddles), passable(BOARD_CELLS, 0), targetAt(BOARD_CELLS, -1) {}
+
+    void reset() { roomID = -1; }       // forget the fields (new game)
+
+    // Direction self should be heading in this cycle, standing in room id (STAY when nothing is worth walking to)
+    Direction think(const Screen& room, int id, const Player& self, int budgetMicros = CPU_TICK_BUDGET_US);
+
+    // Key to press this cycle (0 for none) for self, standing in room id
+    char decide(const Screen& room, int id, const Player& self, int budgetMicros = CPU_TICK_BUDGET_US) {
+        const Direction dir = think(room, id, self, budgetMicros);
+        return dir == self.getDir() ? 0 : self.getKey(dir);
+    }
+};
@@ -0,0 +1,96 @@
+#include "DistanceField.h"
+#include <algorithm>
+
+constexpr int CLOCK_CHECK_CELLS = 64;      // cells settled between deadline checks
+
+// The up to 4 board neighbours of cell, as cell indices; returns how many
+static int neighbours(int cell, int (&out)[4]) {
+    const int x = cell % SCREEN_WIDTH, y = cell / SCREEN_WIDTH;
+    int n = 0;
+    if (x > 0) out[n++] = cell - 1;
+    if (x < SCREEN_WIDTH - 1) out[n++] = cell + 1;
+    if (y > 0) out[n++] = cell - SCREEN_WIDTH;
+    if (y < SCREEN_HEIGHT - 1) out[n++] = cell + SCREEN_WIDTH;
+    return n;
+}
+
+void DistanceField::build(const std::vector<Point>& cells) {
+    sources = cells;
+    dirty = true;
+}
+
+void DistanceField::restart() {
+    std::fill(dist.begin(), dist.end(), UNREACHABLE);
+    std::fill(isSource.begin(), isSource.end(), 0);
+    pending = {};
+    clearing.clear();
+    reseed.clear();
+    dirty = false;
+
+    for (const Point& p : sources) {
+        if (!Point::checkLimits(p)) continue;
+        const int cell = p.getY() * SCREEN_WIDTH + p.getX();
+        dist[cell] = 0;
+        isSource[cell] = 1;
+        seed(cell);
+    }
+}
+
+// Opened cells can only shorten distances: their neighbours are queued again and relax into them.
+// Blocked cells can lengthen them: every cell whose distance may have been counted through one is
+// cleared (the cells one step further out, and so on), then refilled from the cells around the cleared area.
+void DistanceField::update(const std::vector<int>& opened, const std::vector<int>& blocked) {
+    if (!isReady()) {           // distances are still half built - start over at the next work()
+        dirty = true;
+        return;
+    }
+    for (int cell : blocked)
+        if (!isSource[cell]) clearing.push_back(cell);
+    reseed.insert(reseed.end(), opened.begin(), opened.end());
+}
+
+bool DistanceField::work(const uint8_t* passable, std::chrono::steady_clock::time_point deadline) {
+    if (dirty) restart();
+
+    int around[4];
+    int steps = 0;
+    auto outOfTime = [&steps, &deadline] {
+        return ++steps % CLOCK_CHECK_CELLS == 0 && std::chrono::steady_clock::now() >= deadline;
+    };
+
+    while (!clearing.empty()) {
+        if (outOfTime()) return false;
+        const int cell = clearing.back();
+        clearing.pop_back();
+        if (dist[cell] == UNREACHABLE) continue;
+
+        const uint16_t d = dist[cell];
+        dist[cell] = UNREACHABLE;
+        reseed.push_back(cell);
+        for (int i = 0, n = neighbours(cell, around); i < n; ++i)
+            if (!isSource[around[i]] && dist[around[i]] == d + 1) clearing.push_back(around[i]);
+    }
+
+    while (!reseed.empty()) {
+        if (outOfTime()) return false;
+        const int cell = reseed.back();
+        reseed.pop_back();
+        for (int i = 0, n = neighbours(cell, around); i < n; ++i) seed(around[i]);
+    }
+
+    while (!pending.empty()) {
+        if (outOfTime()) return false;
+
+        const Entry top = pending.top();
+        pending.pop();
+        if (top.first != dist[top.second]) continue;      // improved since it was queued
+
+        for (int i = 0, n = neighbours(top.second, around); i < n; ++i) {
+            const int next = around[i];
+            if (isSource[next] || !passable[next] || dist[next] <= top.first + 1) continue;
+            dist[next] = static_cast<uint16_t>(top.first + 1);
+            pending.push({ dist[next], static_cast<uint16_t>(next) });
+        }
+    }
+    return true;
+}
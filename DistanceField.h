@@ -0,0 +1,47 @@
+#pragma once
+#include "Utils.h"
+#include "GameDefs.h"
+#include "Point.h"
+#include <chrono>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+constexpr uint16_t UNREACHABLE = UINT16_MAX;
+
+// Walking distance (4-neighbour BFS) from every board cell to a set of source cells.
+// passable is indexed [y * SCREEN_WIDTH + x]; sources count as distance 0 even when not passable (doors).
+// build() and update() only note what has to be done. All the work - clearing the distances a blocked
+// cell invalidated and refilling them - runs in work(), which stops at the deadline and picks up there
+// on the next call, so a build or repair can be spread over several ticks.
+class DistanceField {
+private:
+    using Entry = std::pair<uint16_t, uint16_t>;       // distance, cell
+
+    std::vector<Point> sources;
+    std::vector<uint16_t> dist;
+    std::vector<uint8_t> isSource;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pending;
+    std::vector<int> clearing;      // cells whose distance may run through a blocked cell - still to clear
+    std::vector<int> reseed;        // cleared or opened cells - their neighbours are queued once clearing is done
+    bool dirty = false;             // (re)build pending, or a change arrived mid-build and the partial distances can't be repaired
+
+    void seed(int cell) {
+        if (dist[cell] != UNREACHABLE) pending.push({ dist[cell], static_cast<uint16_t>(cell) });
+    }
+    void restart();
+
+public:
+    DistanceField() : dist(BOARD_CELLS, UNREACHABLE), isSource(BOARD_CELLS, 0) {}
+
+    void build(const std::vector<Point>& cells);        // starts over from these sources - distances come from work()
+    void update(const std::vector<int>& opened, const std::vector<int>& blocked);   // passability of these cells flipped
+    bool work(const uint8_t* passable, std::chrono::steady_clock::time_point deadline);   // true once up to date
+
+    bool isReady() const { return pending.empty() && clearing.empty() && reseed.empty() && !dirty; }
+    const std::vector<Point>& getSources() const { return sources; }
+    uint16_t at(const Point& p) const {
+        return Point::checkLimits(p) ? dist[p.getY() * SCREEN_WIDTH + p.getX()] : UNREACHABLE;
+    }
+};
@@ -1,32 +1,33 @@
 #pragma once
 #include "Point.h"
 #include "GameDefs.h"
+#include "Zobrist.h"
 
 class Door {
 private:
 	Point pos;             // Position on the board
-	int doorID;            // Logical ID used to match keys and switches to this door
-	int destRoom;          // ID of the room the door leads to
-	bool isOpen=false;     // Indicates whether the door is open   
-	int neededKeys;        // Number of keys required to open the door
-	char figure;
+	int8_t doorID;         // Logical ID used to match keys and switches to this door
+	int8_t destRoom;       // ID of the room the door leads to (also the figure drawn on screen)
+	int8_t neededKeys;     // Number of keys required to open the door
 
-	SwitchRule rule;       // Type of switch interaction required (if any)
-	bool keyOK;            // True if all required keys have been used
-	bool switchOK;         // True if switch condition is satisfied
+	uint8_t isOpen   : 1;  // Indicates whether the door is open
+	uint8_t keyOK    : 1;  // True if all required keys have been used
+	uint8_t switchOK : 1;  // True if switch condition is satisfied
+	uint8_t rule     : 2;  // Type of switch interaction required (SwitchRule)
+	uint8_t spare    : 3;  // Unused, always 0 - every bit of the record is defined (raw state files)
 
 public:
-	Door() : pos(0, 0), doorID(0), destRoom(0), isOpen(false), neededKeys(0),  // default ctor 
-		figure('0'), rule(NO_RULE), keyOK(false),switchOK(false)
+	Door() : pos(0, 0), doorID(0), destRoom(0), neededKeys(0),  // default ctor 
+		isOpen(false), keyOK(false), switchOK(false), rule(NO_RULE), spare(0)
 	{
 	}
 	Door(Point _pos, int _doorID, int _destRoom, int _neededKeys, SwitchRule _rule,bool _keyOK, bool _switchOK) :      // custom ctor 
-	pos(_pos), doorID(_doorID), destRoom(_destRoom), neededKeys(_neededKeys), rule(_rule), keyOK(_keyOK), switchOK(_switchOK)
+	pos(_pos), doorID(static_cast<int8_t>(_doorID)), destRoom(static_cast<int8_t>(_destRoom)),
+	neededKeys(static_cast<int8_t>(_neededKeys)), isOpen(false), keyOK(_keyOK), switchOK(_switchOK), rule(_rule), spare(0)
 	{
-		figure = '0' + destRoom;
 	}
-	Door(Point _pos, int _dest) : pos(_pos), doorID(0), destRoom(_dest), isOpen(false), neededKeys(0),
-		figure('0' + destRoom), rule(NO_RULE), keyOK(false), switchOK(false)
+	Door(Point _pos, int _dest) : pos(_pos), doorID(0), destRoom(static_cast<int8_t>(_dest)), neededKeys(0),
+		isOpen(false), keyOK(false), switchOK(false), rule(NO_RULE), spare(0)
 	{
 	}
 	// Set Functions
@@ -38,8 +39,8 @@ public:
 
 	void applyRules(int id, int keys, bool open, int ruleCode)
 	{
-		doorID = id;
-		neededKeys = keys;
+		doorID = static_cast<int8_t>(id);
+		neededKeys = static_cast<int8_t>(keys);
 		isOpen = open;
 		if (neededKeys == 0)
 			keyOK = true;
@@ -71,7 +72,12 @@ public:
 	bool checkIsOpen() const { return isOpen; }
 	bool getKeyStatus() const { return keyOK; }
 	bool getSwitchStatus() const { return switchOK; }
-	char getFigure() const { return figure; }
+	char getFigure() const { return static_cast<char>(DIGIT_ZERO + destRoom); }
+	uint64_t hashKey() const {   // Zobrist key of this record
+		uint64_t fields = static_cast<uint8_t>(doorID) | (static_cast<uint8_t>(destRoom) << 8) |
+			(static_cast<uint8_t>(neededKeys) << 16) | (isOpen << 24) | (keyOK << 25) | (switchOK << 26) | (rule << 27);
+		return Zobrist::key(Zobrist::DOOR, Zobrist::pack(pos), fields);
+	}
 
 	// Update Functions
 	void updateKeyOK() {           // Changes key flag to true meaning all keys for the door have been used
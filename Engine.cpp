@@ -0,0 +1,151 @@
+#include "Engine.h"
+#include "AgentEnv.h"
+#include <cstring>
+#include <memory>
+#include <new>
+#include <sstream>
+
+static_assert(ENGINE_SCREEN_WIDTH == SCREEN_WIDTH && ENGINE_SCREEN_HEIGHT == SCREEN_HEIGHT, "Engine.h board size");
+static_assert(ENGINE_NUM_PLAYERS == NUM_PLAYERS && ENGINE_NO_ACTION == NO_ACTION, "Engine.h players / actions");
+static_assert(static_cast<int>(ENGINE_GAME_END) == static_cast<int>(Results::GAME_END), "Engine.h event types");
+
+struct EngineGame {
+    AgentEnv env;
+    bool loaded = false;            // the last engine_load succeeded - there are rooms to run
+    mutable std::string error;      // set by the const calls too
+
+    explicit EngineGame(bool solveRiddles) : env(solveRiddles) {}
+};
+
+// Calls that run or read the rooms need a loaded game; the others are fine before one
+static bool requireLoaded(const EngineGame* game) {
+    if (game->loaded) return true;
+    game->error = "no level set loaded - call engine_load first";
+    return false;
+}
+
+// Runs body, turning an exception (a game bug, out of memory) into engine_last_error and the
+// call's failure value - nothing may unwind through the C interface
+template <typename R, typename F>
+static R guarded(const EngineGame* game, R failure, F body) {
+    try {
+        return body();
+    }
+    catch (const std::exception& e) {
+        if (game) game->error = std::string("exception: ") + e.what();
+    }
+    catch (...) {
+        if (game) game->error = "unknown exception";
+    }
+    return failure;
+}
+
+struct EngineSnapshot {
+    GameSnapshot state;
+};
+
+uint32_t engine_api_version(void) { return ENGINE_API_VERSION; }
+
+EngineGame* engine_create(int solveRiddles) {
+    return guarded<EngineGame*>(nullptr, nullptr, [&] { return new (std::nothrow) EngineGame(solveRiddles != 0); });
+}
+
+void engine_destroy(EngineGame* game) { delete game; }
+
+int engine_load(EngineGame* game, const char* levelDir, uint64_t seed) {
+    return guarded(game, 0, [&] {
+        game->error.clear();
+        game->loaded = false;
+        game->loaded = game->env.reset(levelDir ? levelDir : "", seed);
+        if (game->loaded) return 1;
+        game->error = game->env.getLastError().empty() ? "cannot load the level files" : game->env.getLastError();
+        return 0;
+    });
+}
+
+const char* engine_last_error(const EngineGame* game) { return game->error.c_str(); }
+
+int engine_step(EngineGame* game, int action1, int action2) {
+    return guarded(game, -1, [&] {
+        if (!requireLoaded(game)) return -1;
+        game->env.act(action1, action2);
+        return static_cast<int>(game->env.last().done);
+    });
+}
+
+int engine_observe(EngineGame* game, EngineObservation* out) {
+    return guarded(game, 0, [&] {
+        if (!requireLoaded(game)) return 0;
+        const AgentObservation& obs = game->env.observeNow().observation;
+        out->cycle = obs.cycle;
+        out->room = obs.room;
+        out->gameOver = obs.gameOver;
+        for (int i = 0; i < NUM_PLAYERS; ++i) {
+            const AgentPlayerView& p = obs.players[i];
+            out->players[i] = { p.x, p.y, p.room, p.dir, p.item, p.dead, p.finished, p.lives, p.score };
+        }
+        for (int y = 0; y < SCREEN_HEIGHT; ++y)
+            for (int x = 0; x < SCREEN_WIDTH; ++x) out->cells[y][x] = obs.cells[x][y];
+        return 1;
+    });
+}
+
+// engine_events and engine_cycle only copy out what the last step left behind - nothing to throw
+size_t engine_events(const EngineGame* game, EngineEvent* out, size_t capacity) {
+    const std::vector<Results::Event>& events = game->env.last().events;
+    for (size_t i = 0; i < events.size() && i < capacity; ++i) {
+        const Results::Event& e = events[i];
+        out[i] = { e.cycle, e.type, e.player, e.data1, e.data2, e.correct };
+    }
+    return events.size();
+}
+
+uint64_t engine_cycle(const EngineGame* game) { return game->env.getCycle(); }
+
+uint64_t engine_state_hash(const EngineGame* game) {
+    return guarded<uint64_t>(game, 0, [&] { return game->env.stateHash(); });
+}
+
+EngineSnapshot* engine_snapshot(EngineGame* game) {
+    return guarded<EngineSnapshot*>(game, nullptr, [&]() -> EngineSnapshot* {
+        if (!requireLoaded(game)) return nullptr;
+        std::unique_ptr<EngineSnapshot> snap(new EngineSnapshot);
+        snap->state = game->env.snapshot();
+        return snap.release();
+    });
+}
+
+int engine_restore(EngineGame* game, const EngineSnapshot* snapshot) {
+    return guarded(game, 0, [&] {
+        if (!requireLoaded(game)) return 0;
+        if (static_cast<int>(snapshot->state.rooms.size()) != game->env.getRoomCount()) {
+            game->error = "snapshot of a different set of rooms";
+            return 0;
+        }
+        game->env.restore(snapshot->state);
+        return 1;
+    });
+}
+
+void engine_snapshot_free(EngineSnapshot* snapshot) { delete snapshot; }
+
+size_t engine_save_state(const EngineGame* game, void* buffer, size_t capacity) {
+    return guarded<size_t>(game, 0, [&]() -> size_t {
+        if (!requireLoaded(game)) return 0;
+        std::ostringstream out(std::ios::binary);
+        game->env.saveState(out);
+        const std::string bytes = out.str();
+        if (bytes.size() <= capacity) std::memcpy(buffer, bytes.data(), bytes.size());
+        return bytes.size();
+    });
+}
+
+int engine_load_state(EngineGame* game, const void* buffer, size_t size) {
+    return guarded(game, 0, [&] {
+        if (!requireLoaded(game)) return 0;
+        std::istringstream in(std::string(static_cast<const char*>(buffer), size), std::ios::binary);
+        if (game->env.loadState(in)) return 1;
+        game->error = game->env.getLastError().empty() ? "bad state" : game->env.getLastError();
+        return 0;
+    });
+}
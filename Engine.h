@@ -0,0 +1,108 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// File: Engine.h
+// Description:
+//   C interface of the final2_engine library: the simulation core (GameBase, rooms, entities,
+//   level loaders) without the terminal game, for embedding in harnesses and other languages.
+//   A game is driven like AgentEnv: load, then one step per cycle with an action for each player.
+//   Until a load succeeds, the calls that need rooms fail and set engine_last_error.
+//   A call the game throws in (a game bug, out of memory) fails the same way; nothing unwinds into the caller.
+//   Every function is safe to call on different games from different threads at the same time.
+//   Bump ENGINE_API_VERSION whenever a declaration or record below changes.
+
+#if defined(_WIN32) && defined(ENGINE_SHARED)
+#  ifdef ENGINE_BUILD
+#    define ENGINE_API __declspec(dllexport)
+#  else
+#    define ENGINE_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define ENGINE_API __attribute__((visibility("default")))
+#else
+#  define ENGINE_API
+#endif
+
+#define ENGINE_API_VERSION 2
+#define ENGINE_SCREEN_WIDTH 80
+#define ENGINE_SCREEN_HEIGHT 25
+#define ENGINE_NUM_PLAYERS 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Actions - the player's six keys (Direction order), or no key at all
+enum { ENGINE_RIGHT, ENGINE_DOWN, ENGINE_LEFT, ENGINE_UP, ENGINE_STAY, ENGINE_DISPOSE, ENGINE_NO_ACTION };
+
+// Event types - as in a .results file
+enum { ENGINE_SCREEN_CHANGE, ENGINE_LIFE_LOST, ENGINE_RIDDLE_ANSWERED, ENGINE_GAME_END };
+
+typedef struct EngineGame EngineGame;
+typedef struct EngineSnapshot EngineSnapshot;
+
+typedef struct EnginePlayer {
+    int16_t x, y;
+    uint8_t room;
+    uint8_t dir;            // action it is moving in
+    uint8_t item;           // 0 none, 1 key, 2 bomb, 3 torch
+    uint8_t dead;
+    uint8_t finished;       // reached the final room
+    int32_t lives;
+    int32_t score;
+} EnginePlayer;
+
+typedef struct EngineObservation {
+    uint64_t cycle;
+    int32_t room;           // room the cells belong to (the one on screen)
+    int32_t gameOver;
+    EnginePlayer players[ENGINE_NUM_PLAYERS];
+    char cells[ENGINE_SCREEN_HEIGHT][ENGINE_SCREEN_WIDTH];     // by rows, players drawn in, not terminated
+} EngineObservation;
+
+typedef struct EngineEvent {
+    uint64_t cycle;
+    int32_t type;
+    int32_t player;
+    int32_t data1;          // room number / score of player 1
+    int32_t data2;          // score of player 2 (GAME_END)
+    int32_t correct;        // RIDDLE_ANSWERED
+} EngineEvent;
+
+ENGINE_API uint32_t engine_api_version(void);
+
+// Riddles get a fixed answer: solveRiddles != 0 - right, 0 - wrong. NULL if out of memory.
+ENGINE_API EngineGame* engine_create(int solveRiddles);
+ENGINE_API void engine_destroy(EngineGame* game);
+
+// (Re)starts the game from the level files in levelDir (NULL or "" - the working directory).
+// 0 if they can't be loaded, see engine_last_error.
+ENGINE_API int engine_load(EngineGame* game, const char* levelDir, uint64_t seed);
+ENGINE_API const char* engine_last_error(const EngineGame* game);
+
+// One cycle; returns 1 once the game is over, -1 if no level set is loaded or the step failed
+ENGINE_API int engine_step(EngineGame* game, int action1, int action2);
+// 0 if no level set is loaded or the observation failed
+ENGINE_API int engine_observe(EngineGame* game, EngineObservation* out);
+// Events of the last step; copies up to capacity of them and returns how many there were
+ENGINE_API size_t engine_events(const EngineGame* game, EngineEvent* out, size_t capacity);
+ENGINE_API uint64_t engine_cycle(const EngineGame* game);
+// 0 if it can't be computed, with engine_last_error set
+ENGINE_API uint64_t engine_state_hash(const EngineGame* game);
+
+// In-memory copy of the state, cheap to take (rooms are shared until modified). NULL if nothing is loaded or out of memory.
+// Restores into any game loaded from the same level files; 0 if the rooms don't match.
+ENGINE_API EngineSnapshot* engine_snapshot(EngineGame* game);
+ENGINE_API int engine_restore(EngineGame* game, const EngineSnapshot* snapshot);
+ENGINE_API void engine_snapshot_free(EngineSnapshot* snapshot);
+
+// Binary copy of the state (the keyframe format). Returns the size it needs - nothing is
+// written unless it fits in capacity - or 0 if nothing is loaded.
+// engine_load_state returns 0 if the state doesn't fit the rooms.
+ENGINE_API size_t engine_save_state(const EngineGame* game, void* buffer, size_t capacity);
+ENGINE_API int engine_load_state(EngineGame* game, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
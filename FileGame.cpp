@@ -1,4 +1,8 @@
 #include "FileGame.h"
+#include "StateIO.h"
+#include "Keyframes.h"
+#include <algorithm>
+#include <sstream>
 
 /*void getAllBoardFileNames(std::vector<std::string>& vec_to_fill) {
     namespace fs = std::filesystem;
@@ -23,51 +27,218 @@ void FileGame::handleMessage(const std::string &msg) {
     }
 }
 
-FileGame::FileGame(bool silent) : GameBase(), silentMode(silent) {
+FileGame::FileGame(bool silent, const std::string& stepsFile, const std::string& resultsFile)
+    : GameBase(), silentMode(silent), stepsFile(stepsFile), resultsFile(resultsFile) {
     setGame();
 
-    steps = Steps::loadSteps("adv-world.steps");
-    expectedResults = Results::loadResults("adv - world.results");
+    if (!loadStepsFromFile())
+        return;
 
-    loadGameFiles();
     initGame();
+    ready = loadGameFiles();
+    enableRewind(!silentMode);      // visual replays can be stepped back with the rewind key
+}
+
+// Every event is checked the moment it happens; the replay stops at the first divergence
+void FileGame::checkEvent(const Results::Event& actual) {
+    if (!testPassed) return;        // already diverged
+
+    if (!expectedResults.hasMoreEvents())
+        handleError("Unexpected event: '" + Results::describe(actual) + "'");
+    else {
+        Results::Event expected = expectedResults.popEvent();
+        if (expected != actual)
+            handleError("Expected '" + Results::describe(expected) + "', got '" + Results::describe(actual) + "'");
+    }
+
+    if (!testPassed)
+        isRunning = false;          // no point in playing the rest of the session
 }
 
+// Called after the replay: events are checked while running, only missing ones are left
 void FileGame::compareResults() {
+    if (testPassed && expectedResults.hasMoreEvents())
+        handleError("Missing event: expected '" + Results::describe(expectedResults.peekEvent()) + "'");
 
+    const std::vector<std::pair<size_t, uint64_t>>& hashes = allSteps.getStateHashes();
+    if (testPassed && nextHash < hashes.size())
+        handleError("Replay ended before the state hash of cycle " + std::to_string(hashes[nextHash].first));
 }
 
 
 void FileGame::render() {
-    if (!silentMode) GameBase::render();
+    if (!silentMode) drawFrame();
 }
 
 bool FileGame::loadStepsFromFile() {
+    for (const std::string& name : { stepsFile, resultsFile }) {
+        std::ifstream fileCheck(name);
+        if (!fileCheck.good()) {
+            handleError("Cannot open " + name);
+            return false;
+        }
+    }
+    allSteps = steps = Steps::loadSteps(stepsFile);
+    expectedResults = Results::loadResults(resultsFile);
+    endCycle = std::max(steps.getEndCycle(), expectedResults.getLastCycle());
+    if (!steps.getStateHashes().empty())    // recordings without an end still get every hash checked
+        endCycle = std::max(endCycle, steps.getStateHashes().back().first);
+    setSeed(steps.getRandomSeed());     // the recording's random draws come out the same
+    return true;
 }
 
 
 void FileGame::handleInput() {
-    if (steps.isEmpty()) { // flag for an error?
+    // Replay ends once every step was fed and it passed the session's last cycle
+    // (a finished game idles on until the player leaves, and checkpoints go on being taken)
+    if (steps.isEmpty() && gameCycles > endCycle) {
         isRunning=false;      // leave run()
         return;
     }
 
-    if (steps.isNextStepOnIteration(gameCycles)) {
+    if (!silentMode && Utils::hasInput() && std::toupper(Utils::getChar()) == REWIND) {
+        rewind(REWIND_TICKS);
+        return;
+    }
+
+    while (steps.isNextStepOnIteration(gameCycles)) {
         char ch = steps.popStep();
         processKey(ch);
     }
 }
 
-bool FileGame::handleRiddles(Player& player) {
-    if (silentMode) {
-        if (expectedResults.hasNoMoreRiddles()) {
-            handleError("Mismatch: More riddles encountered than expected in results file.");
+// Riddle answers come from the recorded results, so a replay never waits for the console
+bool FileGame::handleRiddles(Player& player, const Point& nextPos) {
+    if (!screens[currRoomID].getRiddleAt(nextPos)) return true;
+
+    if (expectedResults.hasNoMoreRiddles()) {
+        handleError("Mismatch: More riddles encountered than expected in results file.");
+        return false;
+    }
+    bool result = expectedResults.getNextRiddleResult();
+    return GameBase::handleRiddles(player, nextPos, result);
+}
+
+bool FileGame::enableKeyframes(int interval) {
+    if (!Keyframes::create(keyframeOut, Keyframes::fileFor(stepsFile))) {
+        handleError("Cannot write " + Keyframes::fileFor(stepsFile));
+        return false;
+    }
+    keyframeInterval = interval;
+    return true;
+}
+
+void FileGame::onCycleEnd() {
+    checkStateHash();
+    checkMissingEvent();
+    if (keyframeInterval > 0 && gameCycles % keyframeInterval == 0)
+        Keyframes::append(keyframeOut, *this, gameCycles);
+}
+
+// Events of this cycle were checked as they fired, so one still expected at or before it never happened
+void FileGame::checkMissingEvent() {
+    if (!testPassed || !expectedResults.hasMoreEvents() || expectedResults.peekEvent().cycle > gameCycles)
+        return;
+
+    handleError("Missing event: expected '" + Results::describe(expectedResults.peekEvent()) + "'");
+    isRunning = false;
+}
+
+// Compares the state with the hash the recording stored for this cycle, if it stored one.
+// stateHash is kept up to date by every change, so a check costs a few XORs per room.
+void FileGame::checkStateHash() {
+    const std::vector<std::pair<size_t, uint64_t>>& hashes = allSteps.getStateHashes();
+    while (nextHash < hashes.size() && hashes[nextHash].first < gameCycles)
+        nextHash++;
+    if (nextHash == hashes.size() || hashes[nextHash].first != gameCycles || !testPassed)
+        return;
+
+    if (hashes[nextHash++].second != stateHash()) {
+        handleError("State differs from the recording (state hash mismatch)");
+        isRunning = false;
+    }
+}
+
+// Hashes up to the current cycle belong to the state the game was moved to - none of them is checked
+void FileGame::skipStateHashes() {
+    const std::vector<std::pair<size_t, uint64_t>>& hashes = allSteps.getStateHashes();
+    nextHash = 0;
+    while (nextHash < hashes.size() && hashes[nextHash].first <= gameCycles)
+        nextHash++;
+}
+
+// Steps and expected events are re-aligned with the cycle the game was rewound to
+void FileGame::onRewind() {
+    skipStateHashes();
+    steps = allSteps;
+    steps.skipUntil(gameCycles);
+    expectedResults.skipUntil(gameCycles);
+}
+
+// Restores the last keyframe at or before cycle (if there is one) and replays silently from there
+bool FileGame::seek(size_t cycle) {
+    std::ifstream in;
+    if (Keyframes::open(in, Keyframes::fileFor(stepsFile))) {
+        std::streampos best = -1;
+        uint32_t bestSize = 0;
+        uint64_t frameCycle = 0;
+        uint32_t size = 0;
+
+        // Only the frame headers are read while searching
+        while (StateIO::read(in, frameCycle) && StateIO::read(in, size) && frameCycle <= cycle) {
+            best = in.tellg();
+            bestSize = size;
+            in.seekg(size, std::ios::cur);
+        }
+
+        if (best != std::streampos(-1)) {
+            std::string payload(bestSize, '\0');
+            in.clear();
+            in.seekg(best);
+            in.read(&payload[0], bestSize);
+
+            std::istringstream frame(payload);
+            if (!in || !loadState(frame)) {
+                handleError("Corrupt keyframe in " + Keyframes::fileFor(stepsFile));
+                return false;
+            }
+            steps.skipUntil(gameCycles);
+            expectedResults.skipUntil(gameCycles);
+            skipStateHashes();
+        }
+    }
+
+    isRunning = true;
+    while (gameCycles < cycle && runCycle()) {}
+    return gameCycles == cycle;
+}
+
+// Replays one stretch of the recording: from start (the beginning of the game if null) up to end's
+// cycle, where the game must have the state the checkpoint was taken from - endHash is its stateHash.
+// Without an end the replay runs to its last step and every remaining event is checked.
+bool FileGame::verifySegment(const Keyframe* start, const Keyframe* end, uint64_t endHash) {
+    if (start) {
+        std::istringstream frame(start->payload);
+        if (!loadState(frame)) {
+            handleError("Corrupt checkpoint at cycle " + std::to_string(start->cycle));
             return false;
         }
-        bool result = expectedResults.getNextRiddleResult();
-        return GameBase::handleRiddles(player, result);
+        onRewind();     // steps and expected events line up with the checkpoint's cycle
     }
 
-    return GameBase::handleRiddles(player);
+    if (end)                // the recording went on at least as far as its checkpoints
+        endCycle = std::max(endCycle, static_cast<size_t>(end->cycle));
+    isRunning = true;
+    while ((!end || gameCycles < end->cycle) && runCycle()) {}
+    if (!testPassed) return false;
+
+    if (!end)
+        compareResults();
+    else if (gameCycles != end->cycle)
+        handleError("Replay ended before the checkpoint at cycle " + std::to_string(end->cycle));
+    else if (stateHash() != endHash)
+        handleError("State differs from the checkpoint at cycle " + std::to_string(end->cycle));
+    else if (expectedResults.hasMoreEvents() && expectedResults.peekEvent().cycle <= end->cycle)
+        handleError("Missing event: expected '" + Results::describe(expectedResults.peekEvent()) + "'");
+    return testPassed;
 }
-;
\ No newline at end of file
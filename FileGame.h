@@ -2,41 +2,61 @@
 #include "GameBase.h"
 #include "Steps.h"
 #include "Results.h"
+#include "Keyframes.h"
 
 constexpr int FALSE_SILENT_DELAY=10;
 
 class FileGame : public GameBase {
 private:
     bool silentMode;
+    std::string stepsFile, resultsFile;
     Steps steps;
+    Steps allSteps;             // untouched copy, to re-sync after a rewind
     Results expectedResults, actualResults;
-    bool testPassed;
+    int keyframeInterval = 0;   // 0 - no keyframes are written
+    std::ofstream keyframeOut;
+    size_t nextHash = 0;        // next recorded state hash to check (index into allSteps' hashes)
+    size_t endCycle = 0;        // the replay runs at least this far: the session's end, its last event and hash
+    bool testPassed = true;
+    bool ready = false;         // replay files and level files loaded
     int delay;
     std::vector<std::string> errors;
 
 protected:
     void handleInput() override;
 
-    bool handleRiddles(Player &player) override;
+    bool handleRiddles(Player &player, const Point& nextPos) override;
 
     void render() override;
 
     bool loadStepsFromFile();
 
+    void onCycleEnd() override;
+    void onRewind() override;
+
+    void checkEvent(const Results::Event& actual);   // compares one event with the next expected one
+    void checkStateHash();
+    void skipStateHashes();                          // after the game jumped to another cycle
+    void checkMissingEvent();                        // stops the replay once an expected event is overdue
+
     void onScreenChange(PlayerID id, int room) override {
         actualResults.addScreenChange(gameCycles, id, room);
+        checkEvent(actualResults.lastEvent());
     }
 
     void onLifeLost(PlayerID id) override {
         actualResults.addLifeLost(gameCycles, id);
+        checkEvent(actualResults.lastEvent());
     }
 
     void onRiddle(PlayerID id, bool correct) override {
         actualResults.addRiddle(gameCycles, id, correct);
+        checkEvent(actualResults.lastEvent());
     }
 
     void onGameEnd() override {
         actualResults.addGameEnd(gameCycles,players[0].getScore(), players[1].getScore());
+        checkEvent(actualResults.lastEvent());
     }
 
     int getDelay() const override { return silentMode ? 0 : FALSE_SILENT_DELAY; }
@@ -45,11 +65,20 @@ protected:
     void handleMessage(const std::string& msg) override;
 
 public:
-    explicit FileGame(bool silent);
+    explicit FileGame(bool silent, const std::string& stepsFile = STEPS_FILE,
+                      const std::string& resultsFile = RESULTS_FILE);
 
-    ~FileGame();
+    ~FileGame() = default;
 
+    bool isReady() const { return ready; }
     bool didTestPass() const { return testPassed; }
     void compareResults();
 
+    size_t getCycles() const { return gameCycles; }
+
+    bool enableKeyframes(int interval);   // writes a full-state keyframe every interval cycles
+    bool seek(size_t cycle);              // jumps to the nearest keyframe and simulates up to cycle
+    bool verifySegment(const Keyframe* start, const Keyframe* end, uint64_t endHash);
+    const std::vector<std::string>& getErrors() const { return errors; }
+
 };
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "Fuzzer.h"
+#include "HeadlessGame.h"
+#include "Steps.h"
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <ostream>
+#include <random>
+#include <thread>
+
+// Same vocabulary processKey understands: moves, stay and dispose of each player
+static constexpr char PLAYER1_KEYS[] = { 'D', 'X', 'A', 'W', 'S', 'E' };
+static constexpr char PLAYER2_KEYS[] = { 'L', 'M', 'J', 'I', 'K', 'O' };
+
+Fuzzer::Fuzzer(int threads, int ticks, const std::string& dir)
+    : numThreads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      ticksPerGame(ticks > 0 ? ticks : DEFAULT_FUZZ_TICKS),
+      outDir(dir),
+      coverage(FUZZ_COVERAGE_BITS / 64) {
+}
+
+// Sets the feature's bit; true if no game had reached it before
+bool Fuzzer::markCovered(uint32_t feature) {
+    uint32_t bit = feature % FUZZ_COVERAGE_BITS;
+    uint64_t mask = uint64_t(1) << (bit % 64);
+    if (coverage[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask)
+        return false;
+    featuresSeen++;
+    return true;
+}
+
+// Plays input from a freshly loaded game and stops at the first problem
+Fuzzer::Outcome Fuzzer::play(HeadlessGame& game, const Input& input, bool trackCoverage) {
+    Outcome outcome;
+    game.load();
+
+    for (size_t t = 0; t < input.size() && !game.isOver(); ++t) {
+        try {
+            game.step(input[t]);
+        }
+        catch (const std::exception& e) {
+            outcome.problem = std::string("Exception: ") + e.what();
+        }
+
+        if (outcome.problem.empty() && !game.getLastError().empty())
+            outcome.problem = "Error: " + game.getLastError();
+        if (outcome.problem.empty())
+            game.checkConsistency(outcome.problem, false);
+
+        bool last = t + 1 == input.size() || game.isOver();
+        if (outcome.problem.empty() && last)      // rooms left behind are checked once, at the end
+            game.checkConsistency(outcome.problem);
+
+        if (!outcome.problem.empty()) {
+            outcome.cycle = t + 1;
+            break;
+        }
+        if (trackCoverage) {
+            for (PlayerID id : { PLAYER_1, PLAYER_2 })
+                if (markCovered(game.coverageFeature(id)))
+                    outcome.lastNewCycle = t + 1;
+        }
+    }
+    return outcome;
+}
+
+// Random keys for both players, continuing a corpus entry half of the time
+Fuzzer::Input Fuzzer::makeInput(uint64_t gameSeed) {
+    std::mt19937_64 rng(gameSeed);
+    Input input;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!corpus.empty() && rng() % 2 == 0) {
+            const Input& parent = corpus[rng() % corpus.size()];
+            input.assign(parent.begin(), parent.begin() + rng() % (parent.size() + 1));
+        }
+    }
+
+    // Key density varies between games: some players hammer keys, some mostly wait
+    int chance = 5 + static_cast<int>(rng() % 40);
+    while (static_cast<int>(input.size()) < ticksPerGame) {
+        std::vector<char> keys;
+        if (static_cast<int>(rng() % 100) < chance) keys.push_back(PLAYER1_KEYS[rng() % 6]);
+        if (static_cast<int>(rng() % 100) < chance) keys.push_back(PLAYER2_KEYS[rng() % 6]);
+        input.push_back(std::move(keys));
+    }
+    return input;
+}
+
+// Shrinks a failing input while it keeps failing with exactly the same problem:
+// everything after the failing cycle is cut, then key presses are dropped in halving chunks
+Fuzzer::Input Fuzzer::minimize(HeadlessGame& game, const Input& input, const Outcome& outcome) {
+    std::vector<std::pair<size_t, char>> presses;      // (cycle index, key)
+    for (size_t t = 0; t < outcome.cycle; ++t)
+        for (char ch : input[t])
+            presses.emplace_back(t, ch);
+
+    size_t length = outcome.cycle;
+    auto build = [&length](const std::vector<std::pair<size_t, char>>& keys) {
+        Input candidate(length);
+        for (const auto& press : keys)
+            candidate[press.first].push_back(press.second);
+        return candidate;
+    };
+
+    for (size_t chunk = std::max<size_t>(presses.size() / 2, 1); ; chunk /= 2) {
+        for (size_t start = 0; start < presses.size(); ) {
+            std::vector<std::pair<size_t, char>> fewer(presses.begin(), presses.begin() + start);
+            fewer.insert(fewer.end(), presses.begin() + std::min(start + chunk, presses.size()), presses.end());
+
+            Outcome result = play(game, build(fewer), false);
+            if (result.problem == outcome.problem) {
+                presses = std::move(fewer);         // still fails - keep the smaller input
+                length = result.cycle;              // it may fail sooner now
+                while (!presses.empty() && presses.back().first >= length)
+                    presses.pop_back();
+            }
+            else
+                start += chunk;
+        }
+        if (chunk == 1) break;
+    }
+    return build(presses);
+}
+
+// Writes the input as a replay, with the events the game produced up to the problem as its results
+bool Fuzzer::save(HeadlessGame& game, const Input& input, FuzzFailure& failure) {
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
+    if (ec) return false;
+
+    Steps steps;
+    steps.setRandomSeed(game.getSeed());
+    for (size_t t = 0; t < input.size(); ++t) {
+        for (char ch : input[t]) {
+            steps.addStep(t + 1, ch);
+            failure.keys++;
+        }
+    }
+
+    game.recordEvents(true);
+    play(game, input, false);
+    game.recordEvents(false);
+
+    std::filesystem::path base = std::filesystem::path(outDir) / ("fuzz_" + std::to_string(failures.size()));
+    failure.stepsFile = base.string() + STEPS_EXT;
+    steps.saveSteps(failure.stepsFile);
+    game.getResults().saveResults(base.string() + RESULTS_EXT);
+    return true;
+}
+
+void Fuzzer::worker(int games) {
+    HeadlessGame game;
+
+    for (int g = nextGame++; g < games; g = nextGame++) {
+        Input input = makeInput(seed ^ (static_cast<uint64_t>(g) * 0x9E3779B97F4A7C15ull));
+        Outcome outcome = play(game, input, true);
+        gamesPlayed++;
+        ticksPlayed += static_cast<long long>(outcome.problem.empty() ? input.size() : outcome.cycle);
+
+        if (outcome.problem.empty()) {
+            if (outcome.lastNewCycle > 0) {          // reached new ground - worth building on
+                input.resize(outcome.lastNewCycle);
+                std::lock_guard<std::mutex> lock(mutex);
+                corpus.push_back(std::move(input));
+            }
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!problemsSeen.insert(outcome.problem).second) continue;
+        }
+
+        Input smallest = minimize(game, input, outcome);
+        FuzzFailure failure;
+        failure.problem = outcome.problem;
+        failure.cycle = smallest.size();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        save(game, smallest, failure);
+        failures.push_back(failure);
+    }
+}
+
+bool Fuzzer::run(int games, uint64_t runSeed) {
+    seed = runSeed;
+    nextGame = 0;
+
+    HeadlessGame probe;                  // the level files must load before any game is worth playing
+    if (!probe.load()) return false;
+
+    std::vector<std::thread> pool;
+    int count = std::min(numThreads, games);
+    for (int t = 1; t < count; t++)
+        pool.emplace_back(&Fuzzer::worker, this, games);
+    worker(games);                       // the calling thread works too
+    for (std::thread& th : pool)
+        th.join();
+    return true;
+}
+
+int Fuzzer::report(std::ostream& out) const {
+    for (const FuzzFailure& f : failures) {
+        out << "FAIL  " << f.problem << "\n      cycle " << f.cycle << ", " << f.keys << " key presses";
+        if (!f.stepsFile.empty())
+            out << ", saved as " << f.stepsFile;
+        out << '\n';
+    }
+
+    out << gamesPlayed.load() << " games, " << ticksPlayed.load() << " cycles, "
+        << featuresSeen.load() << " coverage features, corpus of " << corpus.size()
+        << ", " << failures.size() << " distinct problems (seed " << seed << ", "
+        << numThreads << " threads)\n";
+    return static_cast<int>(failures.size());
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class HeadlessGame;
+
+constexpr int DEFAULT_FUZZ_TICKS = 3000;         // length of one fuzzed game
+constexpr int FUZZ_COVERAGE_BITS = 1 << 21;      // size of the shared coverage bitmap
+
+// A problem the fuzzer found, after its input was minimized
+struct FuzzFailure {
+    std::string problem;      // exception text, reported error or broken invariant
+    std::string stepsFile;    // replay that reproduces it (empty if it couldn't be saved)
+    size_t cycle = 0;         // cycle the problem shows up on
+    size_t keys = 0;          // key presses left after minimization
+};
+
+// Plays many headless games on random key streams, spread over a fixed pool of worker threads.
+// Every cycle is checked for exceptions, reported errors and GameBase::checkConsistency.
+// Inputs that reach new (room, positions, items) features join a corpus, and half of the
+// games continue from a corpus entry instead of starting blind.
+// Each distinct problem is minimized and saved as <dir>/fuzz_<n>.steps + .results.
+class Fuzzer {
+public:
+    using Input = std::vector<std::vector<char>>;     // keys pressed on each cycle (index 0 = cycle 1)
+
+private:
+    struct Outcome {
+        std::string problem;      // empty - the input ran clean
+        size_t cycle = 0;         // cycle the problem showed up on
+        size_t lastNewCycle = 0;  // last cycle that reached a new coverage feature
+    };
+
+    int numThreads;
+    int ticksPerGame;
+    std::string outDir;
+    uint64_t seed = 0;
+
+    std::vector<std::atomic<uint64_t>> coverage;      // one bit per coverage feature seen so far
+    std::atomic<int> featuresSeen{0};
+    std::atomic<int> nextGame{0};
+    std::atomic<int> gamesPlayed{0};
+    std::atomic<long long> ticksPlayed{0};
+
+    std::mutex mutex;                                  // guards the members below
+    std::vector<Input> corpus;
+    std::set<std::string> problemsSeen;                // each problem is minimized only once
+    std::vector<FuzzFailure> failures;
+
+    bool markCovered(uint32_t feature);
+    Outcome play(HeadlessGame& game, const Input& input, bool trackCoverage);
+    Input makeInput(uint64_t gameSeed);
+    Input minimize(HeadlessGame& game, const Input& input, const Outcome& outcome);
+    bool save(HeadlessGame& game, const Input& input, FuzzFailure& failure);
+    void worker(int games);
+
+public:
+    Fuzzer(int threads, int ticks, const std::string& dir);
+
+    bool run(int games, uint64_t seed);       // false if the level files can't be loaded
+    int report(std::ostream& out) const;      // prints totals and every failure, returns how many
+};
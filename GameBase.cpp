@@ -1,5 +1,7 @@
 #include "GameBase.h"
+#include "StateIO.h"
 #include <iostream>
+#include <algorithm>
 #include <fstream>
 #include <cstdio>
 
@@ -17,36 +19,252 @@ void GameBase::setGame() {
 }
 
 
-// Main game loop � manages input, updates game logic, and renders frames.
-void GameBase::run() {
-    isRunning = true;      // setting flags
-    gameOver = false;
+// Input + logic of one cycle. Returns false if the game loop should stop.
+bool GameBase::runCycle() {
+    beginJournal();
+    gameCycles++;
+    handleInput();     // handle user's input
+
+    if (rewound) {     // input rewound the game - this cycle is already undone
+        rewound = false;
+        return isRunning;
+    }
+
+    // input may request to leave run(); update world state only in active gameplay
+    if (isRunning && !gameOver) update();
+    endJournal();
+
+    if (!isRunning) return false;
+
+    onCycleEnd();
+    return true;
+}
+
+// Writes everything a cycle depends on: global progress, both players and every room
+void GameBase::saveState(std::ostream& out) const {
+    StateIO::write(out, static_cast<uint64_t>(gameCycles));
+    StateIO::write(out, currRoomID);
+    StateIO::write(out, gameOver);
+    for (const Player& player : players)
+        player.saveState(out);
+    StateIO::write(out, playerRoom);
+    StateIO::write(out, roomsDone);
+    StateIO::write(out, playerFinished);
+
+    StateIO::write(out, static_cast<uint32_t>(screens.size()));
+    for (const Screen& room : screens)
+        room.saveState(out);
+}
+
+// Same contents as saveState, as text: names are prefixed p1./p2. and room<N>.
+void GameBase::dumpState(std::ostream& out) const {
+    out << "cycle " << gameCycles << '\n'
+        << "currRoom " << currRoomID << '\n'
+        << "gameOver " << gameOver << '\n'
+        << "seed " << randomSeed << '\n';
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        const std::string prefix = "p" + std::to_string(i + 1) + ".";
+        out << prefix << "room " << playerRoom[i] << '\n'
+            << prefix << "roomsDone " << roomsDone[i] << '\n'
+            << prefix << "finished " << playerFinished[i] << '\n';
+        players[i].dumpState(out, prefix);
+    }
+    for (size_t i = 0; i < screens.size(); ++i)
+        screens[i].dumpState(out, "room" + std::to_string(i) + ".");
+}
+
+bool GameBase::loadState(std::istream& in) {
+    uint64_t cycle = 0;
+    uint32_t numRooms = 0;
+    if (!StateIO::read(in, cycle) || !StateIO::read(in, currRoomID) || !StateIO::read(in, gameOver))
+        return false;
+    for (Player& player : players) {
+        if (!player.loadState(in)) return false;
+    }
+    if (!StateIO::read(in, playerRoom) || !StateIO::read(in, roomsDone) ||
+        !StateIO::read(in, playerFinished) || !StateIO::read(in, numRooms))
+        return false;
+
+    if (numRooms != screens.size()) {     // saved with a different set of level files
+        handleError("Saved state does not match the loaded rooms.");
+        return false;
+    }
+    clearHistory();
+    for (Screen& room : screens) {
+        if (!room.loadState(in)) return false;
+    }
+    gameCycles = static_cast<size_t>(cycle);
+    return true;
+}
+
+// A room's revision changes with every mutation of its board or objects, so a room still at the
+// revision it had when it was copied is unchanged and the copy can be reused.
+GameSnapshot GameBase::snapshot() {
+    sharedRooms.resize(screens.size());
+    sharedRevision.resize(screens.size());
+
+    GameSnapshot snap;
+    for (size_t i = 0; i < screens.size(); ++i) {
+        if (!sharedRooms[i] || sharedRevision[i] != screens[i].getRevision()) {
+            sharedRooms[i] = std::make_shared<const Screen>(screens[i]);    // touched since last time
+            sharedRevision[i] = screens[i].getRevision();
+        }
+    }
+    snap.rooms = sharedRooms;
+
+    std::copy(players, players + NUM_PLAYERS, snap.players);
+    std::copy(playerRoom, playerRoom + NUM_PLAYERS, snap.playerRoom);
+    std::copy(roomsDone, roomsDone + NUM_PLAYERS, snap.roomsDone);
+    std::copy(playerFinished, playerFinished + NUM_PLAYERS, snap.playerFinished);
+    snap.currRoomID = currRoomID;
+    snap.gameOver = gameOver;
+    snap.gameCycles = gameCycles;
+    return snap;
+}
+
+// Only rooms that may differ from the snapshot are copied back: a room is skipped only if it is
+// unchanged since it was equal to the very copy the snapshot holds. The hashes are just a quick
+// way to spot a room that certainly changed.
+void GameBase::restore(const GameSnapshot& snap) {
+    screens.resize(snap.rooms.size());
+    sharedRooms.resize(snap.rooms.size());
+    sharedRevision.resize(snap.rooms.size());
+    for (size_t i = 0; i < snap.rooms.size(); ++i) {
+        bool same = screens[i].getStateHash() == snap.rooms[i]->getStateHash() &&
+                    sharedRooms[i] == snap.rooms[i] && sharedRevision[i] == screens[i].getRevision();
+        if (!same)
+            screens[i] = *snap.rooms[i];
+        sharedRevision[i] = screens[i].getRevision();
+    }
+    sharedRooms = snap.rooms;       // the live rooms now match these copies
+    clearHistory();
+
+    std::copy(snap.players, snap.players + NUM_PLAYERS, players);
+    std::copy(snap.playerRoom, snap.playerRoom + NUM_PLAYERS, playerRoom);
+    std::copy(snap.roomsDone, snap.roomsDone + NUM_PLAYERS, roomsDone);
+    std::copy(snap.playerFinished, snap.playerFinished + NUM_PLAYERS, playerFinished);
+    currRoomID = snap.currRoomID;
+    gameOver = snap.gameOver;
+    gameCycles = snap.gameCycles;
+}
+
+// Rewind Functions
+
+void GameBase::enableRewind(bool enable) {
+    rewindEnabled = enable;
+    clearHistory();
+}
+
+// Forgets all history, including the tick being recorded (used when rooms are replaced wholesale)
+void GameBase::clearHistory() {
+    if (journaling) {
+        for (Screen& room : screens)
+            room.setJournal(nullptr);
+        journaling = false;
+    }
+    history.clear();
+    historyBytes = 0;
+}
 
-    render();              // draw the initial room before any movement
+// Starts recording a tick: the global state is copied, room changes are journaled by the rooms themselves
+void GameBase::beginJournal() {
+    if (!rewindEnabled) return;
+
+    std::copy(players, players + NUM_PLAYERS, pendingTick.players);
+    std::copy(playerRoom, playerRoom + NUM_PLAYERS, pendingTick.playerRoom);
+    std::copy(roomsDone, roomsDone + NUM_PLAYERS, pendingTick.roomsDone);
+    std::copy(playerFinished, playerFinished + NUM_PLAYERS, pendingTick.playerFinished);
+    pendingTick.currRoomID = currRoomID;
+    pendingTick.gameOver = gameOver;
+    pendingTick.gameCycles = gameCycles;
+    pendingTick.rooms.clear();
+
+    pendingRooms.resize(screens.size());
+    for (size_t i = 0; i < screens.size(); ++i)
+        screens[i].setJournal(&pendingRooms[i]);
+    journaling = true;
+}
 
-    while (isRunning) {
-        gameCycles++;
-        handleInput();     // handle user's input
+// Moves the recorded tick into the history, dropping the oldest ticks past the memory cap
+void GameBase::endJournal() {
+    if (!journaling) return;
+    journaling = false;
 
-        if (!isRunning) break;   // input may request to leave run()
+    pendingTick.bytes = 0;
+    for (size_t i = 0; i < screens.size(); ++i) {
+        screens[i].setJournal(nullptr);
+        if (pendingRooms[i].empty()) continue;
 
-        if (!gameOver) update(); // update world state only in active gameplay
+        pendingTick.bytes += pendingRooms[i].byteSize();
+        pendingTick.rooms.emplace_back(static_cast<int>(i), std::move(pendingRooms[i]));
+        pendingRooms[i] = RoomDelta();
+    }
+    pendingTick.bytes += sizeof(TickDelta) + pendingTick.rooms.capacity() * sizeof(pendingTick.rooms[0]);
 
-        if (!isRunning) break;
+    historyBytes += pendingTick.bytes;
+    history.push_back(std::move(pendingTick));
+    pendingTick = TickDelta();
 
-        render();                // redraw everything after update
-        Utils::delay(getDelay());
+    while (historyBytes > REWIND_MEMORY_CAP && !history.empty()) {
+        historyBytes -= history.front().bytes;
+        history.pop_front();
     }
 }
 
-// Updates game state for all players
+int GameBase::rewind(int ticks) {
+    if (journaling) {       // called from inside a cycle: that partial cycle is undone too
+        endJournal();
+        ticks++;
+        rewound = true;
+    }
+
+    int undone = 0;
+    for (; undone < ticks && !history.empty(); ++undone) {
+        const TickDelta& tick = history.back();
+
+        for (const auto& room : tick.rooms)
+            screens[room.first].undo(room.second);
+
+        std::copy(tick.players, tick.players + NUM_PLAYERS, players);
+        std::copy(tick.playerRoom, tick.playerRoom + NUM_PLAYERS, playerRoom);
+        std::copy(tick.roomsDone, tick.roomsDone + NUM_PLAYERS, roomsDone);
+        std::copy(tick.playerFinished, tick.playerFinished + NUM_PLAYERS, playerFinished);
+        currRoomID = tick.currRoomID;
+        gameOver = tick.gameOver;
+        gameCycles = tick.gameCycles;
+
+        historyBytes -= tick.bytes;
+        history.pop_back();
+    }
+
+    onRewind();
+    return undone;
+}
+
+// Advances the simulation by one cycle, using the given keys as that cycle's input.
+// Pure logic - nothing is read from or written to the console, so it can run headless at full speed.
+void GameBase::step(const std::vector<char>& keys) {
+    beginJournal();
+    gameCycles++;
+    for (char ch : keys)
+        processKey(ch);
+
+    if (!gameOver) update();
+    endJournal();
+}
+
+// Updates game state for all players.
+// The tick runs in two phases: every player first proposes the cells it intends to cross
+// (its sub-step path), then the sub-steps of all players are resolved in lockstep -
+// collisions and pushes are decided from the proposals of everyone at once, and only
+// then are the moves committed. No player gets an advantage from being processed first.
 void GameBase::update() {
     Screen& room = screens[currRoomID];
-    room.clearIllumination();           // ��� ���� ��� ��� ����� ������ ���� �� ����
+    room.clearIllumination();
 
-    for (int i = 0; i < NUM_PLAYERS; i++)
-        prevPos[i] = players[i].getPos();
+    MovePlan plans[NUM_PLAYERS];
 
+    // Phase 1 - proposals
     for (int i = 0; i < NUM_PLAYERS; i++) {
         Player& player = players[i];
 
@@ -59,76 +277,315 @@ void GameBase::update() {
             continue;
         }
 
-        handleTorch(players[i]);
+        handleTorch(player);
+        planMove(i, plans[i]);
+    }
 
-        room = screens[playerRoom[i]];
+    // Phase 2 - resolve and commit, one sub-step index at a time
+    int roomAtStart = currRoomID;
+    for (int k = 0; k < MAX_PATH && currRoomID == roomAtStart; k++) {
+        if (!resolveSubStep(plans, k))
+            break;        // nobody is moving anymore
+    }
 
-        int steps = player.getSpeed();
+    handleBombs();        // ticking bombs only once per frame
 
-        if (player.isAccelerating())
-            player.tickAcceleration();
+    // The board now matches the objects, whether or not the room is ever printed
+    screens[roomAtStart].syncItems();
+    if (currRoomID != roomAtStart)
+        screens[currRoomID].syncItems();
 
-        // Inner loop � handles cell-by-cell movement if speed > 1.
-        for (int s = 0; s < steps; s++) {
-            // accelerated movement
-            if (player.isAccelerating()) {
-                bool stop = handleAcceleratedMovement(player, i);
-                if (stop) break;
+    if (std::all_of(playerFinished, playerFinished + NUM_PLAYERS, [](bool done) { return done; })) {
+        gameOver = true;
+        onGameEnd();
+    }
+}
 
-                continue; // skip normal movement block
-            }
+// Builds the cells the player intends to cross this tick (speed steps, each one or two cells when accelerating)
+void GameBase::planMove(int idx, MovePlan& plan) {
+    Player& player = players[idx];
 
-            Point nextPos = player.getNextPos();
+    int steps = player.getSpeed();
+    if (steps > MAX_SUB_STEPS) steps = MAX_SUB_STEPS;
 
-            if (room.isLegendCell(nextPos)) break;
+    if (player.isAccelerating())
+        player.tickAcceleration();
 
-            if (handleSprings(player)) break;  // may override direction/force
+    plan.length = 0;
+    plan.accelerated = player.isAccelerating();
+    plan.done = false;
 
-            if (handleTeleports(player)) break;
+    Point start = player.getPos();
+    Point p = start;
+    for (int s = 0; s < steps; s++) {
+        if (plan.accelerated) {
+            Point sub[2];
+            int count = player.getAccelerationSubSteps(p, sub);
+            for (int c = 0; c < count; c++)
+                plan.path[plan.length++] = p = sub[c];
+        }
+        else {
+            p = p.next(player.getDir());
+            plan.path[plan.length++] = p;
+        }
+    }
 
-            if (handleObstacles(player, nextPos)) break;  // may override direction/force
+    // One sweep finds the first cell of the launch path that needs the full handler chain
+    plan.clearUntil = 0;
+    if (plan.accelerated && player.getCompression() == 0)
+        plan.clearUntil = screens[currRoomID].sweep(start, plan.path, 0, plan.length, player.getDir());
+}
 
-            if (!handleRiddles(player)) {
-                player.setDirection(STAY);
-                break;
-            }
+// Resolves sub-step k of every player's plan at once, then commits the moves that survived.
+// Returns true if some player still has sub-steps left.
+bool GameBase::resolveSubStep(MovePlan plans[NUM_PLAYERS], int k) {
+    StepIntent intent[NUM_PLAYERS];
+    Point target[NUM_PLAYERS];
 
-            if (!room.isCellFree(nextPos)) {
-                // If player's in acceleration, wall stops it
-                if (player.isAccelerating())
-                    player.stopAcceleration();
-                break;
-            }
+    // Each player checks the features of its own target cell (walls, springs, riddles...)
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        intent[i] = STEP_STOP;
+        if (plans[i].done || k >= plans[i].length || !isActiveInRoom(i)) {
+            plans[i].done = true;
+            continue;
+        }
+        target[i] = plans[i].path[k];
+
+        if (k < plans[i].clearUntil) {
+            intent[i] = STEP_MOVE;      // plain cell on a swept path - nothing to handle
+            continue;
+        }
+        intent[i] = checkSubStep(i, target[i], plans[i].accelerated);
+        if (intent[i] == STEP_STOP)
+            plans[i].done = true;
+    }
+
+    // Conflicts between players - combined pushes first, since they decide who actually advances
+    bool pushed[NUM_PLAYERS];
+    for (int i = 0; i < NUM_PLAYERS; i++)
+        pushed[i] = (intent[i] == STEP_PUSH);
+
+    if (resolvePushes(intent, target)) {
+        // a moved obstacle may now lie on someone's swept path
+        for (int i = 0; i < NUM_PLAYERS; i++) {
+            if (plans[i].clearUntil > k + 1)
+                plans[i].clearUntil = screens[currRoomID].sweep(target[i], plans[i].path, k + 1, plans[i].length, players[i].getDir());
+        }
+    }
+    resolvePlayerConflicts(intent, target);
 
-            if (playersCollide(i, nextPos)) break;  // other player collision
+    // Commit
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        if (intent[i] != STEP_MOVE) {
+            plans[i].done = true;
+            continue;
+        }
+        Player& player = players[i];
+        player.stepTo(target[i]);
 
-            player.move();   // commit movement
+        if (k < plans[i].clearUntil)
+            continue;
 
-            // Interactions
+        if (plans[i].accelerated) {
+            handleCollectibles(player);   // collect items mid-flight
+            handleSwitch(player);         // toggle switch mid-flight
+            handleDoor(player);
+        }
+        else {
             handleDoor(player);
             handleSwitch(player);
             handleCollectibles(player);
+        }
+
+        // A push ends the player's movement; after actions the player may also have moved rooms or died
+        if (pushed[i] || playerRoom[i] != currRoomID || player.getDead())
+            plans[i].done = true;
+        else if (plans[i].accelerated && player.isAccelerating() && player.getCompression() == 0)   // sweep the rest of the path
+            plans[i].clearUntil = screens[currRoomID].sweep(player.getPos(), plans[i].path, k + 1, plans[i].length, player.getDir());
+    }
+
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        if (!plans[i].done) return true;
+    }
+    return false;
+}
+
+// Checks the player's target cell against the room's features.
+// Returns STEP_MOVE / STEP_PUSH if the player still wants to enter the cell, STEP_STOP otherwise.
+StepIntent GameBase::checkSubStep(int idx, const Point& target, bool accelerated) {
+    Screen& room = screens[currRoomID];
+    Player& player = players[idx];
+
+    if (room.isLegendCell(target)) return STEP_STOP;
 
-            // After actions player may have moved rooms or died
-            if (playerRoom[i] != currRoomID || player.getDead())
-                break;
+    if (accelerated && !room.isCellFree(target)) {
+        player.stopAcceleration();      // wall stops acceleration
+        return STEP_STOP;
+    }
+
+    if (handleSprings(player)) return STEP_STOP;  // may override direction/force
+
+    if (handleTeleports(player)) return STEP_STOP;
+
+    if (room.isObstacle(target) && room.getObstacleAt(target))
+        return STEP_PUSH;               // decided together with the other players' pushes
+
+    if (!handleRiddles(player, target)) {
+        player.setDirection(STAY);
+        return STEP_STOP;
+    }
+
+    if (!room.isCellFree(target)) {
+        // If player's in acceleration, wall stops it
+        if (player.isAccelerating())
+            player.stopAcceleration();
+        return STEP_STOP;
+    }
+    return STEP_MOVE;
+}
+
+// Touching obstacles form a chain that moves as one: the chain moves if the combined force of
+// all players pushing any part of it in the same direction (plus players directly behind a pusher)
+// covers the combined size of the chain. Returns true if any obstacle moved.
+bool GameBase::resolvePushes(StepIntent intent[NUM_PLAYERS], const Point target[NUM_PLAYERS]) {
+    Screen& room = screens[currRoomID];
+    bool anyMoved = false;
+
+    for (int i = 0; i < NUM_PLAYERS; i++) {
+        if (intent[i] != STEP_PUSH) continue;
+
+        Obstacle* ob = room.getObstacleAt(target[i]);
+        if (!ob) {                  // already moved away by an earlier push this sub-step
+            intent[i] = STEP_STOP;
+            continue;
+        }
+        Direction dir = stepDir(players[i].getPos(), target[i]);
+        int mass = collectPushChain(ob, dir);
+
+        // Gather everyone pushing this chain in the same direction
+        bool inGroup[NUM_PLAYERS] = {};
+        int force = 0;
+        for (int j = i; j < NUM_PLAYERS; j++) {
+            if (intent[j] == STEP_PUSH && chainCells.test(target[j].getY() * SCREEN_WIDTH + target[j].getX())
+                && stepDir(players[j].getPos(), target[j]) == dir) {
+                inGroup[j] = true;
+                force += players[j].getSpeed();
+            }
+        }
+        // ... and those pushing a pusher from behind
+        for (int j = 0; j < NUM_PLAYERS; j++) {
+            if (intent[j] != STEP_MOVE || stepDir(players[j].getPos(), target[j]) != dir) continue;
+            for (int g = 0; g < NUM_PLAYERS; g++) {
+                if (inGroup[g] && target[j] == players[g].getPos())
+                    force += players[j].getSpeed();
+            }
+        }
+
+        bool moves = force >= mass && canMovePushChain(dir);
+        if (moves)
+            room.pushObstacles(pushChain, dir);     // checkConsistency verifies the board still shows every body cell
+        anyMoved |= moves;
+
+        for (int j = 0; j < NUM_PLAYERS; j++) {
+            if (inGroup[j])
+                intent[j] = moves ? STEP_MOVE : STEP_STOP;   // pushers step into the obstacle's old cells
         }
     }
+    return anyMoved;
+}
 
-    handleBombs();        // ticking bombs only once per frame
+// Uses the proposals of all players to decide who is blocked by whom.
+// A player may enter a cell whose occupant is leaving it this sub-step; head-on swaps,
+// two players aiming at the same cell, and moving into a blocked player all fail.
+void GameBase::resolvePlayerConflicts(StepIntent intent[NUM_PLAYERS], const Point target[NUM_PLAYERS]) {
+    bool changed = true;
+    while (changed) {          // blocking one player may block the ones following it
+        changed = false;
+
+        for (int i = 0; i < NUM_PLAYERS; i++) {
+            if (intent[i] != STEP_MOVE) continue;
+            const Point& myPos = players[i].getPos();
+
+            for (int j = 0; j < NUM_PLAYERS; j++) {
+                if (j == i || !isActiveInRoom(j)) continue;
+                const Point& otherPos = players[j].getPos();
+                bool otherLeaves = intent[j] == STEP_MOVE && target[j] != otherPos && target[j] != myPos;
+
+                bool blocked =
+                    (target[i] == otherPos && !otherLeaves) ||                              // occupied and staying (or swapping)
+                    (intent[j] == STEP_MOVE && target[i] == target[j] && target[i] != myPos); // both aim at the same cell
+
+                if (blocked) {
+                    players[i].bumpedInto(players[j]);
+                    intent[i] = STEP_STOP;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
 
-    if (playerFinished[PLAYER_1] && playerFinished[PLAYER_2]) {
-        gameOver = true;
-        onGameEnd();
+bool GameBase::isActiveInRoom(int idx) const {
+    return !playerFinished[idx] && playerRoom[idx] == currRoomID && !players[idx].getDead();
+}
+
+// Combines the rooms' incrementally maintained hashes with the (fixed-size) player and game records.
+// Cost is O(rooms + players) - no board or object traversal.
+uint64_t GameBase::stateHash() const {
+    uint64_t h = 0;
+
+    for (size_t i = 0; i < screens.size(); ++i)
+        h ^= Zobrist::key(Zobrist::ROOM, i, screens[i].getStateHash());
+
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        h ^= players[i].hashKey(i);
+        h ^= Zobrist::key(Zobrist::GAME, static_cast<uint64_t>(i),
+            static_cast<uint8_t>(playerRoom[i]) | (static_cast<uint64_t>(roomsDone[i]) << 8) | (static_cast<uint64_t>(playerFinished[i]) << 40));
     }
+    h ^= Zobrist::key(Zobrist::GAME, NUM_PLAYERS, static_cast<uint64_t>(currRoomID) | (static_cast<uint64_t>(gameOver) << 32));
+    return h;
+}
+
+// Checks the invariants every cycle must keep. On failure problem says which one broke.
+// Without allRooms only the rooms with a player in them are hashed - the cheap per-cycle check.
+bool GameBase::checkConsistency(std::string& problem, bool allRooms) const {
+    for (size_t i = 0; i < screens.size(); ++i) {
+        bool active = static_cast<int>(i) == currRoomID ||
+                      std::find(playerRoom, playerRoom + NUM_PLAYERS, static_cast<int>(i)) != playerRoom + NUM_PLAYERS;
+        if (!allRooms && !active) continue;
+
+        if (screens[i].getStateHash() != screens[i].computeHash()) {
+            problem = "Room " + std::to_string(i) + ": incremental hash out of sync with its contents";
+            return false;
+        }
+        if (!screens[i].obstacleCellsIntact()) {
+            problem = "Room " + std::to_string(i) + ": an obstacle body cell is missing from the board";
+            return false;
+        }
+    }
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        if (playerRoom[i] < 0 || playerRoom[i] >= static_cast<int>(screens.size())) {
+            problem = "Player " + std::to_string(i + 1) + " is in a room that doesn't exist";
+            return false;
+        }
+        if (!playerFinished[i] && !Point::checkLimits(players[i].getPos())) {
+            problem = "Player " + std::to_string(i + 1) + " is outside the board";
+            return false;
+        }
+    }
+    return true;
 }
 
 // Init Functions
 void GameBase::initGame() {
     screens.clear();
+    sharedRooms.clear();            // copies of the rooms of the last game
+    clearHistory();
     // --- Set global game state ---
     gameOver = false;
     currRoomID = ROOM1_SCREEN;
+    gameCycles = 0;
 
     // Set player progress
     roomsDone[PLAYER_1] = roomsDone[PLAYER_2] = 0;
@@ -139,8 +596,12 @@ void GameBase::initGame() {
     constexpr char keys1[] = { 'D','X','A','W','S','E' };
     constexpr char keys2[] = { 'L','M','J','I','K','O' };
 
-    players[PLAYER_1].setPlayer(Point(3, 9), '$', keys1);
-    players[PLAYER_2].setPlayer(Point(3, 11), '&', keys2);
+    players[PLAYER_1].setPlayer(Point(PLAYER_START_X[PLAYER_1], PLAYER_START_Y[PLAYER_1]), '$', keys1);
+    players[PLAYER_2].setPlayer(Point(PLAYER_START_X[PLAYER_2], PLAYER_START_Y[PLAYER_2]), '&', keys2);
+}
+
+std::string GameBase::levelPath(const std::string& name) const {
+    return levelDir.empty() ? name : levelDir + "/" + name;
 }
 
 bool GameBase::loadGameFiles() {  // *Developed with AI assistance*
@@ -152,9 +613,10 @@ bool GameBase::loadGameFiles() {  // *Developed with AI assistance*
     for (int i = 1; i <= MAX_ROOMS_CAPACITY; ++i)
     {
         snprintf(filenameBuffer, sizeof(filenameBuffer), "adv-world_%02d.screen", i);
-        std::ifstream fileCheck(filenameBuffer);
+        std::string path = levelPath(filenameBuffer);
+        std::ifstream fileCheck(path);
         if (fileCheck.good())
-            foundFiles.emplace_back(filenameBuffer);
+            foundFiles.emplace_back(path);
     }
     // No screen files found
     if (foundFiles.empty())
@@ -234,7 +696,7 @@ bool GameBase::initGameFiles(std::vector<std::string>& foundFiles)
 }
 
 bool GameBase::loadRiddles() {
-    std::ifstream file("riddles.txt");
+    std::ifstream file(levelPath("riddles.txt"));
     if (!file.is_open()) {
         handleError("Cannot load riddles file");
         return false;
@@ -247,6 +709,11 @@ bool GameBase::loadRiddles() {
         std::getline(file, dummy);
         std::getline(file, question);
         std::getline(file, answer);
+        if (roomID < 0 || roomID >= static_cast<int>(screens.size()) || !Point::checkLimits(x, y)) {
+            handleError("Riddle outside the rooms: room " + std::to_string(roomID) +
+                " at (" + std::to_string(x) + "," + std::to_string(y) + ")");
+            return false;
+        }
         Riddle* r = screens[roomID].getRiddleAt(Point(x, y));
 
         if (!r) {
@@ -263,7 +730,7 @@ bool GameBase::loadRiddles() {
 }
 
 bool GameBase::loadRiddles(int loadRoomID) {
-    std::ifstream file("riddles.txt");
+    std::ifstream file(levelPath("riddles.txt"));
     if (!file.is_open()) {
         handleError("Cannot load riddles file");
         return false;
@@ -277,6 +744,11 @@ bool GameBase::loadRiddles(int loadRoomID) {
         std::getline(file, question);
         std::getline(file, answer);
         if (roomID != loadRoomID) continue;
+        if (!Point::checkLimits(x, y)) {
+            handleError("Riddle outside the board in room " + std::to_string(roomID) +
+                " at (" + std::to_string(x) + "," + std::to_string(y) + ")");
+            return false;
+        }
         Riddle* r = screens[roomID].getRiddleAt(Point(x, y));
 
         if (!r) {
@@ -294,11 +766,9 @@ bool GameBase::loadRiddles(int loadRoomID) {
 // Helper Functions
 
 void GameBase::moveRoom(Player& player, int dest) {
-    int idx = (&player == &players[PLAYER_1]) ? PLAYER_1 : PLAYER_2;      // determine which player is moving
+    int idx = static_cast<int>(&player - players);      // determine which player is moving
     onScreenChange(static_cast<PlayerID>(idx), dest);
 
-    int other = 1 - idx;                             // index of the other player
-
     // --- Final Room Logic ---
     if (isFinalRoom(dest)) {
         Point startP = getStartPoint(player, idx);   // starting position inside the final screen
@@ -308,14 +778,15 @@ void GameBase::moveRoom(Player& player, int dest) {
 
         player.setStartPos(startP);
 
-        // According to the rules: if only one player is finished,
-        // we return to the second player
-        if (!playerFinished[other]) {
-            currRoomID = playerRoom[other];
+        // According to the rules: while another player hasn't finished,
+        // we return to that player
+        const bool* waiting = std::find(playerFinished, playerFinished + NUM_PLAYERS, false);
+        if (waiting != playerFinished + NUM_PLAYERS) {
+            currRoomID = playerRoom[waiting - playerFinished];
             player.addScore(scoreValue(ScoreEvent::FinishGameFirst));
         }
         else {
-            currRoomID = dest;         // both players are in the final room
+            currRoomID = dest;         // all players are in the final room
             player.addScore(scoreValue(ScoreEvent::FinishGameSecond));
             gameOver = true;
         }
@@ -333,15 +804,12 @@ void GameBase::moveRoom(Player& player, int dest) {
     player.setStartPos(startP);
     player.addScore(scoreValue(ScoreEvent::OpenDoor));
 
-    // decide which room should currently be displayed:
-    if (roomsDone[PLAYER_1] < roomsDone[PLAYER_2])
-        currRoomID = playerRoom[PLAYER_1];       // player 1 is behind
-
-    else if (roomsDone[PLAYER_2] < roomsDone[PLAYER_1])
-        currRoomID = playerRoom[PLAYER_2];       // player 2 is behind
-
-    else
-        currRoomID = playerRoom[idx];     // same progress - follow the moving player
+    // decide which room should currently be displayed: the room of the player furthest behind,
+    // the moving player's room when it is one of them
+    int behind = static_cast<int>(std::min_element(roomsDone, roomsDone + NUM_PLAYERS) - roomsDone);
+    if (roomsDone[idx] == roomsDone[behind])
+        behind = idx;               // same progress - follow the moving player
+    currRoomID = playerRoom[behind];
 }
 
 // Calculates the player's starting position in the next room based on the door's position
@@ -368,57 +836,6 @@ Point GameBase::getStartPoint(Player& player, int idx) const {
    return startPos;
 }
 
-// Checks if the current player and the other player are about to step into the same cell
-bool GameBase::playersCollide(int idx, const Point& nextPos) {
-    int other = 1 - idx;
-
-    // Only relevant if both players are in the same room
-    if (playerRoom[other] != playerRoom[idx]) return false;
-
-    Point otherPos = players[other].getPos();
-    Point otherNext = players[other].getNextPos();
-
-    Screen& room = screens[currRoomID];
-
-    // No physical contact = no collision
-    if (nextPos != otherPos) return false;
-
-    Direction myDir = players[idx].getDir();
-    Direction otherDir = players[other].getDir();
-    bool otherBlocked = (otherNext != otherPos);    // true if other is blocked by an object
-
-    // Case 1: other player in stay mode = collision
-    if (otherDir == STAY) {
-        players[idx].bumpedInto(players[other]);
-        return true;
-    }
-
-    // Case 2: head-on collision (opposite directions)
-    if (Point::areOpposite(myDir, otherDir)) {
-        players[idx].bumpedInto(players[other]);
-        return true;
-    }
-
-    // Case 3: other player is blocked
-    if (otherBlocked) {
-        players[idx].bumpedInto(players[other]);
-        bool blockedByObstacle = room.isObstacle(otherNext);
-        if (blockedByObstacle) {
-            if (chainPushSuccess(idx, myDir, otherNext)) {
-                players[idx].setPushing(true);
-                return false;
-            }
-            return true;
-        }
-
-        players[idx].bumpedInto(players[other]);
-        return true;    // collision
-    }
-
-    // Otherwise: same direction (chasing) = no collision
-    return false;
-}
-
 // Handle Functions
 
 void GameBase::handleDoor(Player& player) {
@@ -438,17 +855,19 @@ void GameBase::handleDoor(Player& player) {
             if (isMatchingKey(player, room, d)) // if player has a key & key fits the door
             {
                 player.clearInventory(); // take the key from player
-                d->useKey();             // one less key needed
                 player.addScore(scoreValue(ScoreEvent::UseKey));  // adding score
 
-                if (d->getNeededKeys() == 0)   // check if more keys are needed
-                    d->updateKeyOK();         // change key flag
+                room.modify(*d, [](Door& door) {
+                    door.useKey();                    // one less key needed
+                    if (door.getNeededKeys() == 0)    // check if more keys are needed
+                        door.updateKeyOK();           // change key flag
+                });
             }
         }
     }
 
     if (d->getKeyStatus() && d->getSwitchStatus()) {
-        d->open();
+        room.modify(*d, [](Door& door) { door.open(); });
         moveRoom(player, dest);
     }
 }
@@ -460,13 +879,9 @@ void GameBase::handleSwitch(Player& player) {
     if (!room.isSwitch(p)) return;  // no switch at this cell
 
     Switch* sw = room.getSwitchAt(p);
-    sw->toggle();
+    room.modify(*sw, [](Switch& s) { s.toggle(); });
 
-    // Update switch character on screen
-    char c = room.charAt(p);
-    room.erase(p);
-    char fig = (c == '/' ? 'o' : '/');
-    room.drawChar(p, fig);
+    room.place(p, sw->getFigure());   // update switch character on the board
 
     int id = sw->getDoorID();
     updateDoorBySwitches(id);
@@ -533,43 +948,28 @@ void GameBase::handleBombs() {
     //Updates bomb timers in the current room and triggers explosions
     Screen& room = screens[currRoomID];
     std::vector<Bomb>& bombs = room.getBombs();
-    std::vector<Point> toExplode;
+    blastStack.clear();
+    tickedBombs.clear();
 
     // Check which bombs are ready to explode
     for (auto& bomb : bombs) {
-        if (bomb.tick())
-            toExplode.push_back(bomb.getPos());
+        if (!bomb.isActive() || !bomb.isTicking())
+            continue;       // nothing to count down - and no change to journal
+        bool exploded = false;
+        room.modify(bomb, [&exploded](Bomb& b) { exploded = b.tick(); });
+        if (exploded)
+            tickedBombs.push_back(bomb.getPos());
     }
 
-    // Explode bombs after iteration
-    for (const auto& p : toExplode)
+    // Explode bombs after iteration (including any chain reaction)
+    for (const Point& p : tickedBombs)
         explodeBomb(p);
 }
 
-// Handles interaction between a human player and a riddle
-bool GameBase::handleRiddles(Player& player) {
-    Screen& room = screens[currRoomID];
-    const Point& nextPos = player.getNextPos();
-
-    // Check if there is a riddle at the next position
-    Riddle* r = room.getRiddleAt(nextPos);
-    if (r == nullptr) return true;
-
-    Utils::clearScreen();
-    Utils::restoreConsole();
-    bool solved = r->solve();
-
-    // Restore game screen after riddle interaction
-    Utils::initConsole();
-    Utils::clearScreen();
-
-    return handleRiddles(player, solved);
-}
-
-
-bool GameBase::handleRiddles(Player& player, bool solved) {
+// Applies the answer to the riddle at nextPos. How the answer is obtained (console, results file...)
+// is up to the derived handleRiddles(player, nextPos).
+bool GameBase::handleRiddles(Player& player, const Point& nextPos, bool solved) {
     Screen& room = screens[currRoomID];
-    const Point& nextPos = player.getNextPos();
 
     Riddle* r = room.getRiddleAt(nextPos);
     if (r == nullptr) return true;
@@ -593,29 +993,6 @@ void GameBase::handleTorch(Player& player) {
         room.illuminateMap(player.getPos());
 }
 
-bool GameBase::handleObstacles(Player& player, const Point& nextPos) {
-    Screen& room = screens[currRoomID];
-    Point p = nextPos;
-
-    // no obstacle at this cell - player can continue moving
-    if (!room.isObstacle(p)) return false;
-
-    Obstacle* ob = room.getObstacleAt(p);
-    if (ob == nullptr) return false;
-
-    Direction dir = player.getDir();
-    int force = calcForce(player, ob, dir);
-
-    if (!ob->canBePushed(force)) return true; // too weak - stop
-
-    auto nextBody = ob->getNextBody(dir);
-    if (!canMoveObstacle(nextBody, ob)) return true; // obstacle blocking the way
-
-    room.pushObstacle(*ob, dir);
-    player.setPos(p);
-    return true;  // player can continue moving
-}
-
 void GameBase::handleCollectibles(Player& player) {
     Screen& room = screens[currRoomID];
     Point p = player.getPos();
@@ -660,32 +1037,44 @@ bool GameBase::handleDispose(Player& player) {
     if (room.charAt(p) != ' ') return false;  // Cannot place an item on an occupied cell
 
     const ItemType& type = player.checkItem();
-    int index = player.getIndex();
+    int id = player.getItemId();
+
+    // The stored item can be missing (e.g. carried into another room) - the item is lost
+    bool stored = (type == KEY && room.getStoredKey(id)) || (type == BOMB && room.getStoredBomb(id)) ||
+                  (type == TORCH && room.getStoredTorch(id));
+    if (!stored) {
+        player.clearInventory();
+        return false;
+    }
 
     switch (type) {
         case KEY: {
             // Take key from storage, place it on the board, and activate it
-            Key& k = room.getStoredKey(index);
-            k.setPos(p);
+            Key& k = *room.getStoredKey(id);
+            room.modify(k, [&p](Key& key) {
+                key.setPos(p);
+                key.activate();
+            });
             player.clearInventory();
             player.setDisposeFlag(true);
-            k.activate();
             break;
         }
         case BOMB: {
             // Take bomb from storage and arm it at the player's position
-            Bomb& b = room.getStoredBomb(index);
+            Bomb& b = *room.getStoredBomb(id);
             player.clearInventory();
             player.setDisposeFlag(true);
-            b.arm(p);
+            room.modify(b, [&p](Bomb& bomb) { bomb.arm(p); });
             break;
         }
         case TORCH: {
-            Torch& t = room.getStoredTorch(index);
-            t.setPos(p);
+            Torch& t = *room.getStoredTorch(id);
+            room.modify(t, [&p](Torch& torch) {
+                torch.setPos(p);
+                torch.activate();
+            });
             player.clearInventory();
             player.setDisposeFlag(true);
-            t.activate();
             break;
         }
         default: break;
@@ -693,75 +1082,17 @@ bool GameBase::handleDispose(Player& player) {
     return true;
 }
 
-bool GameBase::handleAcceleratedMovement(Player& player, int index)
-{
-    Screen& room = screens[playerRoom[index]];
-
-    // build up to MAX_SUB_STEPS intermediate positions
-    Point sub[MAX_SUB_STEPS];
-    int count = player.getAccelerationSubSteps(sub);
-
-    for (int k = 0; k < count; k++) {
-        player.setPushing(false);
-
-        Point nextPos = sub[k];
-
-        if (room.isLegendCell(nextPos)) return true;
-
-        if (!room.isCellFree(nextPos)) {
-            // If player's in acceleration, wall stops it
-            if (player.isAccelerating())
-                player.stopAcceleration();
-            break;
-        }
-
-        // spring interaction may override direction or launch
-        if (handleSprings(player)) return true;
-
-        if (handleTeleports(player)) return true;
-
-        if (handleObstacles(player, nextPos)) return true;
-
-        if (!handleRiddles(player)) {
-            player.setDirection(STAY);
-            return true;
-        }
-
-        // wall collision stops acceleration
-        if (!room.isCellFree(nextPos)){
-            player.stopAcceleration();
-            return true;
-        }
-
-        // player collision
-        if (playersCollide(index, nextPos)) return true;
-
-        if (player.isPushing()){
-            player.setPos(nextPos);
-            break;
-        }
-        player.setPos(nextPos);          // commit movement
-        handleCollectibles(player);   // collect items mid-flight
-        handleSwitch(player);         // toggle switch mid-flight
-        handleDoor(player);
-
-        // if moved rooms or died � stop movement now
-        if (playerRoom[index] != currRoomID || player.getDead())
-            return true;
-    }
-    return false;   // completed accelerated steps normally
-}
-
 // Helper to Handle Functions
 
 bool GameBase::isMatchingKey(Player& player, Screen& room, Door* door) const {
     if (player.checkItem() != KEY) return false;     // player doesn't hold a key
 
-    int keyIndex = player.getIndex();                // get access to key object
-    const Key& k = room.getStoredKey(keyIndex);
+    int keyId = player.getItemId();                  // get access to key object
+    const Key* k = room.getStoredKey(keyId);
+    if (!k) return false;                            // key no longer in this room's storage
 
     // compare key's doorID to the door's doorID (not destination room)
-    return k.getDoorID() == door->getDoorID();
+    return k->getDoorID() == door->getDoorID();
 }
 
 void GameBase::updateDoorBySwitches(int id)
@@ -783,44 +1114,78 @@ void GameBase::updateDoorBySwitches(int id)
 
     // Update the switchOK flag by the door's rule
     if (d.getRule() == ALL_ON)
-        d.updateSwitchOK(total == countOn);
+        room.modify(d, [=](Door& door) { door.updateSwitchOK(total == countOn); });
 
     else if (d.getRule() == ALL_OFF)
-        d.updateSwitchOK(countOn == 0);
+        room.modify(d, [=](Door& door) { door.updateSwitchOK(countOn == 0); });
 }
 
-void GameBase::explodeBomb(Point center) {
-    Screen& room = screens[currRoomID];    // *Developed with ChatGPT assistance*
-    room.removeBombAt(center);
-
-    // getting all points that are in the bomb explosion area
-    // the points are in order: from the center - out
-    auto blastPattern = Bomb::getBlastPattern(center, BOMB_BLAST_RADIUS);
-
-    for (const auto& ray : blastPattern) {
-        for (size_t i = 0; i < ray.size(); i++) {
-            Point p = ray[i];
+// Explodes the bomb at center and every bomb its blast reaches, depth first: a chained bomb goes
+// off at once (it may clear '=' / '|' next to it) and the ray that hit it then carries on.
+// Runs on blastStack rather than the call stack; each bomb explodes at most once per tick.
+void GameBase::explodeBomb(const Point& center) {
+    Screen& room = screens[currRoomID];
+    const auto& table = blastTable<BOMB_BLAST_RADIUS>;
+    constexpr int NUM_RAYS = BlastTable<BOMB_BLAST_RADIUS>::NUM_RAYS;
 
-            if (!Point::checkLimits(p)) break; // the point and those after it in this ray are out of limits
-            char c = room.charAt(p);
+    if (!blastStack.push(center)) return;      // already set off by an earlier chain this tick
+    room.removeBombAt(center);
+    blastCell(room, center);
 
-            if (c == 'W' || c == '=' || c == '|') {
-                if (i == 0 && (c == '=' || c == '|'))       // some barriers ('=' or '|') can be destroyed is those are adjacent to bomb
-                    room.erase(p);
-                break;
+    while (!blastStack.empty()) {
+        BlastStack::Frame& f = blastStack.top();
+        if (f.ray == NUM_RAYS) {
+            blastStack.pop();
+            continue;
+        }
+        // the points of every ray are in order: from the center - out
+        Point p(f.center.getX() + table.dx[f.ray][f.cell], f.center.getY() + table.dy[f.ray][f.cell]);
+
+        if (!f.resume) {
+            if (!blastPasses(room, p, f.cell == 0)) {
+                f.ray++;            // the rest of this ray is shielded
+                f.cell = 0;
+                continue;
             }
-            if (room.removeBombAt(p))
-                explodeBomb(p);
+            Bomb* hitBomb = room.getBombAt(p);
+            if (hitBomb && hitBomb->isActive() && blastStack.push(p)) {    // chain reaction - goes off first
+                f.resume = true;
+                room.removeBombAt(p);
+                blastCell(room, p);
+                continue;
+            }
+        }
+        f.resume = false;
+        blastCell(room, p);
+        if (++f.cell == BOMB_BLAST_RADIUS) {
+            f.ray++;
+            f.cell = 0;
+        }
+    }
+}
 
-            room.removeObjectsAt(p);
+// Whether a blast ray gets into p. Returns false if the ray stops here.
+bool GameBase::blastPasses(Screen& room, const Point& p, bool adjacent) {
+    if (!Point::checkLimits(p)) return false; // the point and those after it in this ray are out of limits
+    char c = room.charAt(p);
 
-            for (auto& player : players) {
-                if (player.getPos() == p)
-                    applyLifeLoss(player);
-            }
+    if (c == BOARD_WALL || c == WALL_HORIZ || c == WALL_VERT) {
+        if (adjacent && c != BOARD_WALL)      // some barriers ('=' or '|') can be destroyed is those are adjacent to bomb
             room.erase(p);
-        }
+        return false;
+    }
+    return true;
+}
+
+// Applies the blast to a single cell it got into
+void GameBase::blastCell(Screen& room, const Point& p) {
+    room.removeObjectsAt(p);
+
+    for (auto& player : players) {
+        if (player.getPos() == p)
+            applyLifeLoss(player);
     }
+    room.erase(p);
 }
 
 Spring* GameBase::findAdjacentSpring(const Point& pos)
@@ -842,7 +1207,7 @@ bool GameBase::compressSpring(Player& player, Spring& sp)
 
     Point tip = sp.getLinkPos(sp.getCurrSize() - 1);
     room.erase(tip);
-    sp.decreaseSize();
+    room.modify(sp, [](Spring& s) { s.decreaseSize(); });
     player.addCompression();
 
     return (sp.getCurrSize() > 0 );    // return true if spring still compressible
@@ -852,7 +1217,8 @@ bool GameBase::compressSpring(Player& player, Spring& sp)
 void GameBase::launchPlayer(Player& player, Spring& sp)
 {
     // Total compression force accumulated by the player
-    int force = sp.springRelease();
+    int force = 0;
+    screens[currRoomID].modify(sp, [&force](Spring& s) { force = s.springRelease(); });
 
     // Apply acceleration if any compression was done
     if (force > 0)
@@ -861,69 +1227,66 @@ void GameBase::launchPlayer(Player& player, Spring& sp)
     player.resetCompression();  // clear stored compression count
 }
 
-int GameBase::calcForce(const Player& pusher, const Obstacle* ob, Direction dir) const
+// Collects the obstacle being pushed and every obstacle it would shove along, one cell in dir.
+// Each body cell is visited once, so the walk is linear in the chain's size.
+// Fills pushChain/chainCells and returns the combined size (mass) of the chain.
+int GameBase::collectPushChain(Obstacle* head, Direction dir)
 {
-    int force = pusher.getSpeed();
-
-    int idx = (&pusher == &players[PLAYER_1]) ? PLAYER_1 : PLAYER_2;
-    int otherIdx = 1 - idx;
-    const Player& other = players[otherIdx];
-
-    if (playerRoom[otherIdx] != currRoomID     // must be in same room
-        || players[otherIdx].getDead()
-        || other.getDir() != dir)              // must move in same direction
-        return force;
-
-    // use snapshot from start of step ONLY
-    Point pusherStart = prevPos[idx];
-    Point otherStart = prevPos[otherIdx];
-
-    // CASE 1: other player directly pushes the same obstacle
-    // CASE 2: chain push (other pushes pusher, pusher pushes obstacle)
-    if (ob->isObBody(otherStart.next(dir))
-        || otherStart == pusherStart.next(Point::opposite(dir)))
-        force += other.getSpeed();
-
-    return force;
+    Screen& room = screens[currRoomID];
+    pushChain.clear();
+    chainCells.reset();
+    int mass = 0;
+
+    auto addToChain = [&](Obstacle* ob) {
+        pushChain.push_back(ob);
+        for (const Point& cell : ob->getBody())
+            chainCells.set(cell.getY() * SCREEN_WIDTH + cell.getX());
+        mass += ob->getSize();
+    };
+
+    addToChain(head);
+    for (size_t i = 0; i < pushChain.size(); i++) {
+        for (const Point& cell : pushChain[i]->getBody()) {
+            Point p = cell.next(dir);
+            if (!Point::checkLimits(p) || chainCells.test(p.getY() * SCREEN_WIDTH + p.getX())) continue;
+
+            Obstacle* touching = room.getObstacleAt(p);
+            if (touching)
+                addToChain(touching);
+        }
+    }
+    return mass;
 }
 
-bool GameBase::canMoveObstacle(const std::vector<Point>& nextBody, const Obstacle* currOb)
+// "Would-move" query for the collected chain: every leading-edge cell (a cell some chain body
+// moves into that the chain does not already cover) must be free. Allocation-free.
+bool GameBase::canMovePushChain(Direction dir)
 {
     Screen& room = screens[currRoomID];
 
-    for (const Point& p : nextBody) {    // Check all body cells of the obstacle
-        if (!Point::checkLimits(p)) return false;
-
-        for (int i = 0; i < NUM_PLAYERS; ++i) {
-            if (playerRoom[i] != currRoomID) continue;
-            if (players[i].getPos() == p) return false;
-        }
-
-        if (room.charAt(p) == ' ') continue;
+    for (const Obstacle* ob : pushChain) {
+        for (const Point& cell : ob->getBody()) {
+            Point p = cell.next(dir);
+            if (!Point::checkLimits(p)) return false;
+            if (chainCells.test(p.getY() * SCREEN_WIDTH + p.getX())) continue;   // vacated by the chain itself
 
-        if (room.isObstacle(p) && currOb->isObBody(p)) continue;
+            for (int i = 0; i < NUM_PLAYERS; ++i) {
+                if (playerRoom[i] != currRoomID) continue;
+                if (players[i].getPos() == p) return false;
+            }
 
-        return false;
+            if (room.charAt(p) != ' ') return false;
+        }
     }
-
     return true;
 }
 
-bool GameBase::chainPushSuccess(int idx, Direction dir, const Point& obstaclePos) {
-    Screen& room = screens[currRoomID];
-    Obstacle* ob = room.getObstacleAt(obstaclePos);
-    if (!ob) return false;
-
-    // check combined force (existing logic)
-    int force = calcForce(players[idx], ob, dir);
-    if (force < ob->getSize()) return false;
-
-    // check obstacle can actually move
-    auto nextBody = ob->getNextBody(dir);
-    if (!canMoveObstacle(nextBody, ob)) return false;
-
-    // push is real and will happen
-    return true;
+// Direction of a single-cell step between two adjacent cells
+Direction GameBase::stepDir(const Point& from, const Point& to) {
+    for (Direction dir : { RIGHT, DOWN, LEFT, UP }) {
+        if (from.next(dir) == to) return dir;
+    }
+    return STAY;
 }
 
 void GameBase::processKey(char ch) {
@@ -950,135 +1313,3 @@ void GameBase::applyLifeLoss(Player& player) {
     player.lowerLife();
 }
 
-
-// UI Display Functions
-void GameBase::displayLegend(const Screen& room) {
-    const LegendArea& legend = room.getLegend();
-    if (!legend.exists) return;
-
-    int x0 = legend.topLeft.getX();
-    int y0 = legend.topLeft.getY();
-
-    // 1. Clear entire legend area
-    for (int y = 0; y < LEGEND_HEIGHT; ++y) {
-        Utils::gotoxy(x0, y0 + y);
-        std::cout << std::string(LEGEND_WIDTH, ' ');
-    }
-
-    // 2. Draw frame
-    // Top border
-    Utils::gotoxy(x0, y0);
-    std::cout << LEGEND_CORNER
-        << std::string(LEGEND_WIDTH - 2, LEGEND_H_BORDER)
-        << LEGEND_CORNER;
-
-    // Side borders
-    for (int y = 1; y < LEGEND_HEIGHT - 1; ++y) {
-        Utils::gotoxy(x0, y0 + y);
-        std::cout << LEGEND_V_BORDER
-            << std::string(LEGEND_WIDTH - 2, ' ')
-            << LEGEND_V_BORDER;
-    }
-
-    // Bottom border
-    Utils::gotoxy(x0, y0 + LEGEND_HEIGHT - 1);
-    std::cout << LEGEND_CORNER
-        << std::string(LEGEND_WIDTH - 2, LEGEND_H_BORDER)
-        << LEGEND_CORNER;
-
-    // 3. Draw content (inside frame)
-
-    int cx = x0 + 1; // content start X
-    int cy = y0 + 1; // content start Y
-
-    int colScore = cx;
-    int colLives = cx + 8;
-    int colInv = cx + 18;
-
-    // --- Header ---
-    Utils::gotoxy(cx + 3, cy);
-
-    std::cout << "SCORE  LIVES  INV";
-
-    // Line 2
-     // --- Player 1 ---
-    Utils::gotoxy(colScore, cy + 1);
-    std::cout << "P1: " << players[PLAYER_1].getScore();
-
-    Utils::gotoxy(colLives, cy + 1);
-    for (int i = 0; i < players[PLAYER_1].getLife(); ++i)
-        std::cout << "<3 ";
-
-    Utils::gotoxy(colInv, cy + 1);
-    std::cout << players[PLAYER_1].getInventoryChar();
-
-    // --- Player 2 ---
-    Utils::gotoxy(colScore, cy + 2);
-    std::cout << "P2: " << players[PLAYER_2].getScore();
-
-    Utils::gotoxy(colLives, cy + 2);
-    for (int i = 0; i < players[PLAYER_2].getLife(); ++i)
-        std::cout << "<3 ";
-
-    Utils::gotoxy(colInv, cy + 2);
-    std::cout << players[PLAYER_2].getInventoryChar();
-}
-
-void GameBase::displayFinalScoreboard() const {
-    int score1 = players[PLAYER_1].getScore();
-    int score2 = players[PLAYER_2].getScore();
-    int totalScore = score1 + score2;
-
-    // Center the scoreboard horizontally
-    const int boxWidth = FINAL_SCOREBOARD_WIDTH;
-    const int startX = (SCREEN_WIDTH - boxWidth) / 2;
-    const int startY = FINAL_SCOREBOARD_START_Y;
-
-    Utils::gotoxy(startX, startY);
-    std::cout << "====================";
-
-    Utils::gotoxy(startX, startY + 1);
-    std::cout << "   FINAL SCORES";
-
-    Utils::gotoxy(startX, startY + 2);
-    std::cout << "--------------------";
-
-    Utils::gotoxy(startX, startY + 3);
-    std::cout << "Player 1 : " << score1;
-
-    Utils::gotoxy(startX, startY + 4);
-    std::cout << "Player 2 : " << score2;
-
-    Utils::gotoxy(startX, startY + 5);
-    std::cout << "--------------------";
-
-    Utils::gotoxy(startX, startY + 6);
-    std::cout << "TEAM SCORE : " << totalScore;
-
-    Utils::gotoxy(startX, startY + 7);
-    std::cout << "====================";
-}
-
-void GameBase::drawPlayers() {
-    for (int i = 0; i < NUM_PLAYERS; ++i) {
-        // if player isn't in current room (moved on to the next one) - no need to draw them
-        if (playerRoom[i] != currRoomID || players[i].getDead())
-            continue;
-
-        // draw players present in the current room
-        players[i].draw();
-    }
-}
-
-// Draws current room and both players.
-void GameBase::render()
-{
-    Screen& room = screens[currRoomID];
-
-    room.drawScreen();
-    drawPlayers();
-
-    isFinalRoom(currRoomID)?displayFinalScoreboard():displayLegend(room);
-
-    std::cout << std::flush;
-};
\ No newline at end of file
@@ -7,13 +7,60 @@
 //#include "Key.h"
 //#include "Bomb.h"
 #include "Spring.h"
+#include "Zobrist.h"
+#include "Random.h"
 //#include "Maps.h"
 #include <fstream>
 #include <string>
 #include <vector>
+#include <bitset>
+#include <memory>
+#include <deque>
 //#include <sstream>
 //#include <algorithm>
 
+constexpr int MAX_PATH = 2 * MAX_SUB_STEPS;     // forced + sideways cell for every speed step
+
+// One player's proposed movement for the current tick (phase 1 of update)
+struct MovePlan {
+    Point path[MAX_PATH];    // cells the player intends to enter, in order
+    int length = 0;
+    bool accelerated = false;
+    int clearUntil = 0;      // accelerated sub-steps before this index cross plain cells (swept once)
+    bool done = true;        // no more sub-steps to resolve this tick
+};
+
+// What a player wants to do in the sub-step being resolved
+enum StepIntent { STEP_STOP, STEP_MOVE, STEP_PUSH };
+
+// Full game state at one cycle. Rooms are immutable and shared between snapshots:
+// a room is copied only if it changed since the previous snapshot was taken.
+struct GameSnapshot {
+    std::vector<std::shared_ptr<const Screen>> rooms;
+    Player players[NUM_PLAYERS];
+    int playerRoom[NUM_PLAYERS];
+    int roomsDone[NUM_PLAYERS];
+    bool playerFinished[NUM_PLAYERS];
+    int currRoomID = 0;
+    bool gameOver = false;
+    size_t gameCycles = 0;
+};
+
+constexpr size_t REWIND_MEMORY_CAP = 8 * 1024 * 1024;   // bytes of tick history kept for rewind
+
+// One tick of rewind history: the game state before the tick and a delta for every room it touched
+struct TickDelta {
+    Player players[NUM_PLAYERS];
+    int playerRoom[NUM_PLAYERS];
+    int roomsDone[NUM_PLAYERS];
+    bool playerFinished[NUM_PLAYERS];
+    int currRoomID = 0;
+    bool gameOver = false;
+    size_t gameCycles = 0;
+    std::vector<std::pair<int, RoomDelta>> rooms;
+    size_t bytes = 0;
+};
+
 class GameBase {
 // ============== PROTECTED - For Derived Classes ==============
 protected:
@@ -24,12 +71,41 @@ protected:
     int playerRoom[NUM_PLAYERS];
     int roomsDone[NUM_PLAYERS];
     bool playerFinished[NUM_PLAYERS];
-    Point prevPos[NUM_PLAYERS];
 
     bool isRunning;
     bool gameOver;
     size_t gameCycles = 0;
 
+    std::string levelDir;           // where the level files are read from (empty - working directory)
+    uint64_t randomSeed = 0;        // seed of the game's random choices
+
+    BlastStack blastStack;      // reused by every chain reaction
+    std::vector<Point> tickedBombs;     // bombs whose timers ran out this tick, in list order
+
+    std::vector<Obstacle*> pushChain;                   // obstacles moved together by the push being resolved
+    std::bitset<SCREEN_WIDTH * SCREEN_HEIGHT> chainCells;   // board cells covered by pushChain
+
+    std::vector<std::shared_ptr<const Screen>> sharedRooms;  // last snapshotted copy of every room
+    std::vector<uint64_t> sharedRevision;   // revision of each live room when it was equal to its shared copy
+
+    // Rewind history - oldest tick first, capped at REWIND_MEMORY_CAP bytes
+    bool rewindEnabled = false;
+    bool journaling = false;        // a tick is being recorded right now
+    bool rewound = false;           // the current cycle was rewound - skip the rest of it
+    std::deque<TickDelta> history;
+    size_t historyBytes = 0;
+    TickDelta pendingTick;
+    std::vector<RoomDelta> pendingRooms;
+
+    // Random draws for the game's random choices: a pure function of the seed, the cycle, the stream
+    // (one per random element) and index (the draw's number within the cycle, below 2^20)
+    uint64_t random(uint64_t stream, uint32_t index = 0) const {
+        return Random::draw(randomSeed, stream, (static_cast<uint64_t>(gameCycles) << 20) | (index & 0xFFFFF));
+    }
+    uint32_t randomBelow(uint32_t bound, uint64_t stream, uint32_t index = 0) const {
+        return Random::below(random(stream, index), bound);
+    }
+
     // ----- Getters -----
     bool isFinalRoom(int dest) const { return dest == static_cast<int>(screens.size()) - 1; }
     PlayerID getPlayerID(const Player& p) const {
@@ -40,11 +116,19 @@ protected:
     void setGame();
 
     // ----- Core Game Loop -----
+    bool runCycle();                 // one cycle of run() without drawing - false once the game loop should stop
+    virtual void onCycleEnd() {}     // called after every simulated cycle of run()
+    virtual void onRewind() {}       // called after rewind() moved the game back
+
+    // ----- Rewind Journal -----
+    void beginJournal();
+    void endJournal();
     void update();
-    virtual void render();
+    virtual void render() = 0;      // draws the current frame (console, nothing...)
 
     // ----- Init Functions -----
     void initGame();
+    std::string levelPath(const std::string& name) const;   // name inside levelDir
     bool loadGameFiles();
     bool initGameFiles(std::vector<std::string>& outFiles);
     bool loadRiddles();
@@ -53,10 +137,17 @@ protected:
     // ----- Game Logic Functions -----
     void moveRoom(Player& p, int dest);
     Point getStartPoint(Player& player, int idx) const;
-    bool playersCollide(int currPlayerIndex, const Point& nextPos);
+    void planMove(int idx, MovePlan& plan);
+    bool resolveSubStep(MovePlan plans[NUM_PLAYERS], int k);
+    StepIntent checkSubStep(int idx, const Point& target, bool accelerated);
+    bool resolvePushes(StepIntent intent[NUM_PLAYERS], const Point target[NUM_PLAYERS]);
+    void resolvePlayerConflicts(StepIntent intent[NUM_PLAYERS], const Point target[NUM_PLAYERS]);
+    bool isActiveInRoom(int idx) const;
     virtual void applyLifeLoss(Player& player);
 
     // ----- Display Functions -----
+    // Console drawing, defined in Console.cpp - only the terminal game builds it
+    void drawFrame();               // current room, players and legend
     void displayLegend(const Screen &room);
     void displayFinalScoreboard() const;
     void drawPlayers();
@@ -67,34 +158,56 @@ protected:
     bool handleSprings(Player& p);
     void handleBombs();
 
-    virtual bool handleRiddles(Player &player);
-    bool handleRiddles(Player &player, bool solved);
-    bool handleObstacles(Player& player, const Point& nextPos);
+    virtual bool handleRiddles(Player &player, const Point& nextPos) = 0;   // asks for an answer (console, file...)
+    bool handleRiddles(Player &player, const Point& nextPos, bool solved);
     void handleTorch(Player& player);
     void handleCollectibles(Player& player);
     bool handleTeleports(Player& player);
     bool handleDispose(Player& p);
-    bool handleAcceleratedMovement(Player& player, int playerIndex);
 
     // ----- Helper Functions -----
     void processKey(char ch);
     bool isMatchingKey(Player& player, Screen& room, Door* door) const;
     void updateDoorBySwitches(int id);
 
-    void explodeBomb(Point center);
+    void explodeBomb(const Point& center);
+    bool blastPasses(Screen& room, const Point& p, bool adjacent);
+    void blastCell(Screen& room, const Point& p);
 
     Spring* findAdjacentSpring(const Point& pos);
     bool compressSpring(Player& player, Spring& sp);
     void launchPlayer(Player& player, Spring& sp);
-    int calcForce(const Player& pusher, const Obstacle* ob, Direction dir) const;
-    bool canMoveObstacle(const std::vector<Point>& nextBody, const Obstacle* currOb);
-    bool chainPushSuccess(int idx, Direction dir, const Point& obstaclePos);
+    int collectPushChain(Obstacle* head, Direction dir);
+    bool canMovePushChain(Direction dir);
+    static Direction stepDir(const Point& from, const Point& to);
 
     // ============== PUBLIC ==============
 public:
     GameBase() = default;
     virtual ~GameBase() = default;
-    void run();
+    void run();                     // console game loop (Console.cpp)
+    void step(const std::vector<char>& keys);   // one headless cycle: keys in, no I/O
+
+    uint64_t stateHash() const;     // 64-bit Zobrist hash of the whole game state
+    bool checkConsistency(std::string& problem, bool allRooms = true) const;   // internal invariants (used by the fuzzer)
+
+    void setLevelDir(const std::string& dir) { levelDir = dir; }    // takes effect on the next loadGameFiles
+    void setSeed(uint64_t seed) { randomSeed = seed; }
+    uint64_t getSeed() const { return randomSeed; }
+
+    // Binary copy of the whole game state, restored on top of the same loaded level files
+    void saveState(std::ostream& out) const;
+    bool loadState(std::istream& in);
+    void dumpState(std::ostream& out) const;    // every field as a "<name> <value>" line (see Bisector)
+
+    // In-memory copy-on-write snapshots (cheap enough to take every cycle)
+    GameSnapshot snapshot();
+    void restore(const GameSnapshot& snap);
+
+    // Rewind: every tick records what it changed, so the last ticks can be undone one by one
+    void enableRewind(bool enable);
+    int rewind(int ticks);          // returns how many ticks were actually undone
+    void clearHistory();
 
     // ----- Pure Virtual -----
     virtual void handleInput() = 0;
@@ -4,6 +4,8 @@
 // Description:
 //   Defines global constants, enums, structs and shared structures used throughout the game.
 
+#include <cstdint>
+
 // SCREEN Constants
 static constexpr int MAX_X = 79;
 static constexpr int MAX_Y = 24;
@@ -19,6 +21,8 @@ static constexpr int MAX_SUB_STEPS = 10;
 // Input Keys Constants
 constexpr char HOME    = 'H';
 constexpr char RESTART = 'R';
+constexpr char REWIND  = 'B';
+constexpr int REWIND_TICKS = 10;     // ticks undone per rewind key press
 
 constexpr int ESC = 27;
 
@@ -33,6 +37,15 @@ static constexpr int ROOM1_SCREEN       = 1;
 constexpr int FINAL_SCOREBOARD_START_Y  = 8;
 constexpr int FINAL_SCOREBOARD_WIDTH    = 20;
 
+// Recorded Game Files
+constexpr const char* STEPS_FILE    = "adv-world.steps";
+constexpr const char* RESULTS_FILE  = "adv-world.results";
+constexpr const char* STEPS_EXT     = ".steps";
+constexpr const char* RESULTS_EXT   = ".results";
+constexpr const char* KEYFRAMES_EXT = ".keyframes";
+constexpr int CHECKPOINT_INTERVAL = 1000;   // cycles between the checkpoints written with a recording
+constexpr int STATE_HASH_INTERVAL = 100;    // cycles between the state hashes stored in a recording's steps
+
 // Menu Constants
 constexpr char START            = '1';
 constexpr char INSTRUCTIONS     = '8';
@@ -66,13 +79,18 @@ constexpr char BOARD_TELEPORT   = '^';
 // GAME Constants
 enum PlayerID { PLAYER_1 = 0, PLAYER_2 = 1 };
 
-enum Direction { RIGHT, DOWN, LEFT, UP, STAY, DISPOSE };
+// Cell each player starts the first room on, indexed by PlayerID
+constexpr int PLAYER_START_X[NUM_PLAYERS] = { 3, 3 };
+constexpr int PLAYER_START_Y[NUM_PLAYERS] = { 9, 11 };
+
+// Small enums are stored in one byte so entity records stay compact
+enum Direction : uint8_t { RIGHT, DOWN, LEFT, UP, STAY, DISPOSE };
 
-enum ItemType { NONE, KEY, BOMB, TORCH };
+enum ItemType : uint8_t { NONE, KEY, BOMB, TORCH };
 
 struct Item {         
     ItemType type = NONE;
-    int Index = -1;
+    int id = -1;          // id of the item in the room's list
 };
 
 inline char itemTypeToChar(ItemType type)
@@ -86,8 +104,9 @@ inline char itemTypeToChar(ItemType type)
     }
 }
 
-enum SwitchRule { ALL_ON, ALL_OFF, NO_RULE };  // combinations of switches to open the door:
+enum SwitchRule : uint8_t { ALL_ON, ALL_OFF, NO_RULE };  // combinations of switches to open the door:
 constexpr int BOMB_BLAST_RADIUS = 3;
+constexpr int BOMB_TIMER        = 5;
 
 // Score\Lives panel
 
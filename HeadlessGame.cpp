@@ -0,0 +1,19 @@
+#include "HeadlessGame.h"
+
+bool HeadlessGame::load() {
+    setGame();
+    initGame();
+    lastError.clear();
+    results = Results();
+    return loadGameFiles();
+}
+
+// Packs the player's room, cell and the item it carries into 32 bits.
+// Two cycles with the same features look alike to a coverage-guided fuzzer.
+uint32_t HeadlessGame::coverageFeature(PlayerID id) const {
+    const Player& player = players[id];
+    const Point p = player.getPos();
+    return static_cast<uint32_t>(p.getX() & 0x7F) | (static_cast<uint32_t>(p.getY() & 0x3F) << 7) |
+           (static_cast<uint32_t>(player.checkItem()) << 13) | (static_cast<uint32_t>(id) << 15) |
+           (static_cast<uint32_t>(playerRoom[id] & 0x1F) << 16);
+}
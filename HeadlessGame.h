@@ -0,0 +1,52 @@
+#pragma once
+#include "GameBase.h"
+#include "Results.h"
+#include <string>
+#include <vector>
+
+// Drives the simulation core with no console at all: no rendering, no delay and no prompts.
+// Input is handed to step() directly, riddles get a fixed answer. Used for tooling and benchmarks.
+class HeadlessGame : public GameBase {
+private:
+    bool riddleAnswer;          // answer given to every riddle
+    std::string lastError;
+    bool recording = false;     // events are kept only when asked for
+    Results results;
+
+protected:
+    void handleInput() override {}      // input only arrives through step()
+    void render() override {}
+
+    bool handleRiddles(Player& player, const Point& nextPos) override {
+        return GameBase::handleRiddles(player, nextPos, riddleAnswer);
+    }
+
+public:
+    explicit HeadlessGame(bool solveRiddles = true) : GameBase(), riddleAnswer(solveRiddles) {}
+
+    bool load();                    // (re)starts the game from the level files
+    bool isOver() const { return gameOver; }
+    size_t getCycle() const { return gameCycles; }
+    const std::string& getLastError() const { return lastError; }
+
+    void recordEvents(bool record) { recording = record; }
+    const Results& getResults() const { return results; }
+
+    uint32_t coverageFeature(PlayerID id) const;   // small digest of where a player is (room, cell, item)
+
+    int getDelay() const override { return 0; }
+    void onScreenChange(PlayerID id, int room) override {
+        if (recording) results.addScreenChange(gameCycles, id, room);
+    }
+    void onLifeLost(PlayerID id) override {
+        if (recording) results.addLifeLost(gameCycles, id);
+    }
+    void onRiddle(PlayerID id, bool correct) override {
+        if (recording) results.addRiddle(gameCycles, id, correct);
+    }
+    void onGameEnd() override {
+        if (recording) results.addGameEnd(gameCycles, players[0].getScore(), players[1].getScore());
+    }
+    void handleError(const std::string& msg) override { lastError = msg; }
+    void handleMessage(const std::string&) override {}
+};
@@ -1,31 +1,37 @@
 #pragma once
 #include "Point.h"
+#include "Zobrist.h"
 
 class Key {
 private:
 	Point pos;           // Position on the board
-	int DoorID;          // Which door does the key open
-	char figure = 'K';
+	int8_t DoorID;       // Which door does the key open
 	bool active;         // True if key is on board
+	uint16_t id;         // Stable within the room's key list - what a player holding it remembers
 public:
-	Key() : pos(0, 0), DoorID(-1), figure('K'), active(false)   // default ctor 
+	Key() : pos(0, 0), DoorID(-1), active(false), id(0)   // default ctor 
 	{
 	}
 
 	Key(Point _pos, int _DoorID)                // custom ctor 
-		: pos(_pos), DoorID(_DoorID), active(true)
+		: pos(_pos), DoorID(static_cast<int8_t>(_DoorID)), active(true), id(0)
 	{
 	}
 
 	// Set Functions
 	void setPos(Point _pos) {pos = _pos;}
-	void setDoorId(int id) { DoorID = id; }
+	void setDoorId(int id) { DoorID = static_cast<int8_t>(id); }
+	void setId(int _id) { id = static_cast<uint16_t>(_id); }
 
 	// Get Functions
 	bool isActive() const { return active; }
 	Point getPos() const { return pos; }
 	int getDoorID() const { return DoorID; }
-	char getFigure() const { return figure; }
+	int getId() const { return id; }
+	char getFigure() const { return BOARD_KEY; }
+	uint64_t hashKey() const {   // Zobrist key of this record
+		return Zobrist::key(Zobrist::KEY, Zobrist::pack(pos), static_cast<uint8_t>(DoorID) | (active << 8));
+	}
 	
 	void activate() { active = true; }          // Marks the key as available (visible on screen).
 	void deactivate() { active = false; }       // Marks the key as collected (no longer visible).
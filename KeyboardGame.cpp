@@ -1,17 +1,29 @@
 #include "KeyboardGame.h"
+#include <random>
 
-KeyboardGame::KeyboardGame() {
+KeyboardGame::KeyboardGame(bool save) : saveMode(save) {
     Utils::initConsole();
 
     fixedScreens[MENU_SCREEN].setMap(MENU_MAP);
     fixedScreens[INSTRUCTIONS_SCREEN].setMap(INSTRUCTIONS_MAP);
 
     setGame();
-    showMenu();      // going into the main menu
+}
+
+KeyboardGame::~KeyboardGame() {
+    Utils::restoreConsole();
+}
+
+// Holds the game until a key is pressed
+void KeyboardGame::pauseGame() {
+    handleMessage("Game paused");
 }
 
 
 void KeyboardGame::handleInput() {
+    if (cpuPlayer2)
+        handleCpuPlayer();
+
     if (!Utils::hasInput())   // no key pressed this frame
         return;
 
@@ -31,6 +43,12 @@ void KeyboardGame::handleInput() {
         return;
     }
 
+    // Step back in time (not while recording - the recording would no longer match)
+    if (c == REWIND) {
+        if (!saveMode) rewind(REWIND_TICKS);
+        return;
+    }
+
     // Player wants to restart room
     if (c == RESTART) {
         if (!restartCurrentRoom())
@@ -38,9 +56,48 @@ void KeyboardGame::handleInput() {
 
         return;
     }
+    // Player 2's keys belong to the computer
+    if (cpuPlayer2 && (players[PLAYER_2].isMoveKey(c) || players[PLAYER_2].isDisposeKey(c)))
+        return;
+
+    if (saveMode) steps.addStep(gameCycles, ch);   // record the key for replays
     processKey(ch);
 }
 
+// The computer presses player 2's keys through the same path as a person would,
+// so recordings replay the same whether or not the computer played
+void KeyboardGame::handleCpuPlayer() {
+    const Player& cpu = players[PLAYER_2];
+    if (gameOver || playerFinished[PLAYER_2] || cpu.getDead() || playerRoom[PLAYER_2] != currRoomID)
+        return;
+
+    char key = companion.decide(screens[currRoomID], currRoomID, cpu);
+    if (!key) return;
+
+    if (saveMode) steps.addStep(gameCycles, key);
+    processKey(key);
+}
+
+// Asks the player the riddle they are about to enter, on the console
+bool KeyboardGame::handleRiddles(Player& player, const Point& nextPos) {
+    Screen& room = screens[currRoomID];
+
+    // Check if there is a riddle at the next position
+    Riddle* r = room.getRiddleAt(nextPos);
+    if (r == nullptr) return true;
+
+    Utils::clearScreen();
+    Utils::restoreConsole();
+    bool solved = false;
+    room.modify(*r, [&solved](Riddle& riddle) { solved = riddle.solve(); });
+
+    // Restore game screen after riddle interaction
+    Utils::initConsole();
+    Utils::clearScreen();
+
+    return GameBase::handleRiddles(player, nextPos, solved);
+}
+
 void KeyboardGame::showMenu() // is it only KeyBoardGame's function?
 {
     char choice = '\0';
@@ -55,11 +112,25 @@ void KeyboardGame::showMenu() // is it only KeyBoardGame's function?
         switch (choice) {
         case START: // Start new game
             initGame();          // prepares the game - map, objects, players
+            steps = Steps();     // a new recording for every game
+            setSeed((static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()());
+            steps.setRandomSeed(randomSeed);
+            results = Results();
+            enableRewind(!saveMode);
+            companion.reset();
 
             if (!loadGameFiles())  // file-related error: return to main menu
                 break;
 
+            if (saveMode && checkpointInterval > 0)
+                Keyframes::create(checkpointOut, Keyframes::fileFor(STEPS_FILE));
+
             run();    // start game
+            if (saveMode) {
+                steps.saveSteps(STEPS_FILE);
+                results.saveResults(RESULTS_FILE);
+                checkpointOut.close();
+            }
             break;
 
         case INSTRUCTIONS:    // Show instructions
@@ -139,6 +210,7 @@ bool KeyboardGame::restartCurrentRoom() {
     if (isFinalRoom(currRoomID)) return true;
 
     // Clear current room state
+    clearHistory();         // the reloaded room can't be rewound past
     screens[currRoomID].clearRoom();
     // Reload room from original file
     if (!reloadRoom(currRoomID)) return false;
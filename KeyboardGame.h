@@ -3,6 +3,9 @@
 #include "Utils.h"
 #include "Steps.h"
 #include "Results.h"
+#include "Keyframes.h"
+#include "CpuPlayer.h"
+#include <fstream>
 #include <vector>
 
 
@@ -12,17 +15,28 @@ private:
     Steps steps;
     Results results;
     Screen fixedScreens[NUM_SCREENS];  // Constant screens like menu\instructions
+    bool cpuPlayer2 = false;           // PLAYER_2 is played by the computer
+    int checkpointInterval = CHECKPOINT_INTERVAL;   // 0 - the recording gets no checkpoints
+    std::ofstream checkpointOut;
+    int hashInterval = STATE_HASH_INTERVAL;         // 0 - the steps get no state hashes
+    CpuPlayer companion;
 
-protected:
-    KeyboardGame();
+    void handleCpuPlayer();
 
+protected:
     void handleInput() override;
+    void render() override { drawFrame(); }
     void pauseGame();
 
+    bool handleRiddles(Player& player, const Point& nextPos) override;
+
 public:
     KeyboardGame(bool save = false);
     ~KeyboardGame();
 
+    void setCpuPlayer(bool on) { cpuPlayer2 = on; }
+    void setCheckpointInterval(int interval) { checkpointInterval = interval; }
+    void setHashInterval(int interval) { hashInterval = interval; }
     void showMenu();
     void showInstructions();
 
@@ -55,4 +69,15 @@ public:
 
     int getDelay() const override {return KEYBOARD_DELAY;}
 
+    // Recordings get a keyframe every checkpointInterval cycles, so they can be verified in parallel segments,
+    // and a state hash every hashInterval cycles, so replays catch drift that produces no event
+    void onCycleEnd() override {
+        if (!saveMode) return;
+        steps.setEndCycle(gameCycles);      // replays run this far, past the last key if the session idled
+        if (checkpointInterval > 0 && gameCycles % checkpointInterval == 0 && checkpointOut.is_open())
+            Keyframes::append(checkpointOut, *this, gameCycles);
+        if (hashInterval > 0 && gameCycles % hashInterval == 0)
+            steps.addStateHash(gameCycles, stateHash());
+    }
+
 };
@@ -0,0 +1,56 @@
+#include "Keyframes.h"
+#include "GameBase.h"
+#include "StateIO.h"
+#include <algorithm>
+#include <sstream>
+
+constexpr char KEYFRAME_MAGIC[4] = { 'K', 'F', 'R', 'M' };
+constexpr uint32_t KEYFRAME_VERSION = 3;
+
+std::string Keyframes::fileFor(const std::string& stepsFile) {
+    std::string base = stepsFile;
+    size_t ext = base.rfind(STEPS_EXT);
+    if (ext != std::string::npos && ext + std::string(STEPS_EXT).size() == base.size())
+        base.erase(ext);
+    return base + KEYFRAMES_EXT;
+}
+
+bool Keyframes::create(std::ofstream& out, const std::string& file) {
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(KEYFRAME_MAGIC, sizeof(KEYFRAME_MAGIC));
+    StateIO::write(out, KEYFRAME_VERSION);
+    return true;
+}
+
+void Keyframes::append(std::ofstream& out, const GameBase& game, uint64_t cycle) {
+    std::ostringstream frame;
+    game.saveState(frame);
+    const std::string payload = frame.str();
+
+    StateIO::write(out, cycle);
+    StateIO::write(out, static_cast<uint32_t>(payload.size()));
+    out.write(payload.data(), payload.size());
+}
+
+bool Keyframes::open(std::ifstream& in, const std::string& file) {
+    in.open(file, std::ios::binary);
+    char magic[sizeof(KEYFRAME_MAGIC)] = {};
+    uint32_t version = 0;
+    return in.read(magic, sizeof(magic)) && StateIO::read(in, version) &&
+           std::equal(magic, magic + sizeof(magic), KEYFRAME_MAGIC) && version == KEYFRAME_VERSION;
+}
+
+bool Keyframes::readAll(const std::string& file, std::vector<Keyframe>& frames) {
+    std::ifstream in;
+    if (!open(in, file)) return false;
+
+    Keyframe frame;
+    uint32_t size = 0;
+    while (StateIO::read(in, frame.cycle) && StateIO::read(in, size)) {
+        frame.payload.assign(size, '\0');
+        if (!in.read(&frame.payload[0], size)) return false;     // cut off in the middle of a frame
+        frames.push_back(frame);
+    }
+    return true;
+}
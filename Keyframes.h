@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class GameBase;
+
+// One saved frame: the cycle it was taken after and the GameBase::saveState bytes
+struct Keyframe {
+    uint64_t cycle = 0;
+    std::string payload;
+};
+
+// Keyframes file: magic + version, then frames of [cycle][payload size][GameBase::saveState payload].
+// Written next to a recording (checkpoints) or while replaying one (-keyframes).
+namespace Keyframes {
+    std::string fileFor(const std::string& stepsFile);     // <steps name>.keyframes
+    bool create(std::ofstream& out, const std::string& file);       // writes the header
+    void append(std::ofstream& out, const GameBase& game, uint64_t cycle);
+    bool open(std::ifstream& in, const std::string& file);          // false if missing or not a keyframes file
+    bool readAll(const std::string& file, std::vector<Keyframe>& frames);
+}
@@ -1,23 +1,211 @@
 #include "FileGame.h"
 #include "KeyboardGame.h"
+#include "HeadlessGame.h"
+#include "ReplayRunner.h"
+#include "Fuzzer.h"
+#include "RoomSolver.h"
+#include "Playtester.h"
+#include "Bisector.h"
+#include "ControlServer.h"
 #include "GameBase.h"
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+constexpr int DEFAULT_BENCH_TICKS = 1000000;
+constexpr int DEFAULT_FUZZ_GAMES = 2000;
+constexpr const char* FUZZ_DIR = "fuzz";     // where minimized failing inputs are saved
+
+// Prints the in-memory size of every board record (used with -sizes).
+static void printSizeReport() {
+	std::cout << "Point    : " << sizeof(Point)    << " bytes\n"
+			  << "Key      : " << sizeof(Key)      << " bytes\n"
+			  << "Torch    : " << sizeof(Torch)    << " bytes\n"
+			  << "Bomb     : " << sizeof(Bomb)     << " bytes\n"
+			  << "Door     : " << sizeof(Door)     << " bytes\n"
+			  << "Switch   : " << sizeof(Switch)   << " bytes\n"
+			  << "Spring   : " << sizeof(Spring)   << " bytes\n"
+			  << "Obstacle : " << sizeof(Obstacle) << " bytes\n"
+			  << "Riddle   : " << sizeof(Riddle)   << " bytes\n"
+			  << "Player   : " << sizeof(Player)   << " bytes\n"
+			  << "Screen   : " << sizeof(Screen)   << " bytes\n";
+}
+
+// Runs the headless core as fast as possible on pseudo-random input and prints ticks per second (used with -bench [ticks]).
+// The second pass also takes a snapshot every tick.
+static int runBenchmark(int ticks) {
+	for (bool withSnapshots : { false, true }) {
+		HeadlessGame game;
+		if (!game.load()) {
+			std::cout << "bench: " << game.getLastError() << "\n";
+			return 1;
+		}
+
+		constexpr char keys[] = { 'D','X','A','W','S','E','L','M','J','I','K','O' };
+		uint32_t rng = 12345;            // fixed seed - every run plays the same game
+		std::vector<char> input;
+		int restarts = 0;
+		GameSnapshot snap;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < ticks; t++) {
+			input.clear();
+			rng = rng * 1664525u + 1013904223u;
+			if ((rng >> 28) < 4) input.push_back(keys[(rng >> 16) % 6]);        // player 1
+			if (((rng >> 24) & 0xF) < 4) input.push_back(keys[6 + (rng >> 8) % 6]);   // player 2
+
+			if (withSnapshots) snap = game.snapshot();
+			game.step(input);
+			if (game.isOver()) {
+				game.load();
+				restarts++;
+			}
+		}
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+		std::cout << (withSnapshots ? "step + snapshot: " : "step:            ")
+				  << ticks << " ticks in " << secs.count() << " s ("
+				  << static_cast<long long>(ticks / secs.count()) << " ticks/s, "
+				  << restarts << " restarts), state hash: "
+				  << std::hex << game.stateHash() << std::dec << "\n";
+	}
+	return 0;
+}
 
 int main(int argc, char* argv[]) {
-	bool saveMode, loadMode, silentMode = false;
+	bool saveMode = false, loadMode = false, silentMode = false, cpuMode = false, verifyMode = false;
+	int checkpointInterval = CHECKPOINT_INTERVAL;
+	int hashInterval = STATE_HASH_INTERVAL;
+	const char* replayDir = nullptr;
+	int threads = 0;              // 0 - one per hardware thread
+	int keyframeInterval = 0;
+	long long seekCycle = -1;
+	int fuzzGames = 0;
+	uint64_t fuzzSeed = std::random_device()();
+	int solveRoom = -1;
+	long long solverStates = 0;
+	int playtestEpisodes = 0;
+	PlaytestAgent playtestAgent = PlaytestAgent::SEEKER;
 
 	for (int i = 1; i < argc; i++) {
 		if (strcmp(argv[i], "-save") == 0) saveMode = true;
 		if (strcmp(argv[i], "-load") == 0) loadMode = true;
 		if (strcmp(argv[i], "-silent") == 0) silentMode = true;
+		if (strcmp(argv[i], "-cpu") == 0) cpuMode = true;      // the computer plays player 2
+		if (strcmp(argv[i], "-verify") == 0) verifyMode = true;
+		if (strcmp(argv[i], "-dumpstate") == 0 && i + 2 < argc) {    // child side of -bisect, see Bisector
+			StateProbe probe;
+			if (!probe.open(argv[i + 1], argv[i + 2])) return 2;
+			probe.serve(std::cin, std::cout);
+			return 0;
+		}
+		if (strcmp(argv[i], "-bisect") == 0 && i + 2 < argc) {     // -bisect <other binary> <steps> [results]
+			std::string steps = argv[i + 2];
+			std::string results = (i + 3 < argc && argv[i + 3][0] != '-') ? argv[i + 3]
+				: steps.substr(0, steps.rfind(STEPS_EXT)) + RESULTS_EXT;
+			return Bisector::run(argv[i + 1], steps, results, std::cout);
+		}
+		if (strcmp(argv[i], "-control") == 0)        // -control [socket]: driven by another process, see ControlServer
+			return ControlServer::run((i + 1 < argc && argv[i + 1][0] != '-') ? argv[i + 1] : "");
+		if (strcmp(argv[i], "-checkpoints") == 0 && i + 1 < argc) checkpointInterval = std::atoi(argv[++i]);
+		if (strcmp(argv[i], "-hashes") == 0 && i + 1 < argc) hashInterval = std::atoi(argv[++i]);
+		if (strcmp(argv[i], "-sizes") == 0) {
+			printSizeReport();
+			return 0;
+		}
+		if (strcmp(argv[i], "-bench") == 0) {
+			int ticks = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+			return runBenchmark(ticks > 0 ? ticks : DEFAULT_BENCH_TICKS);
+		}
+		if (strcmp(argv[i], "-replay") == 0 && i + 1 < argc) replayDir = argv[++i];
+		if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = std::atoi(argv[++i]);
+		if (strcmp(argv[i], "-keyframes") == 0 && i + 1 < argc) keyframeInterval = std::atoi(argv[++i]);
+		if (strcmp(argv[i], "-seek") == 0 && i + 1 < argc) seekCycle = std::atoll(argv[++i]);
+		if (strcmp(argv[i], "-fuzz") == 0) {
+			int games = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+			fuzzGames = games > 0 ? games : DEFAULT_FUZZ_GAMES;
+		}
+		if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc) fuzzSeed = std::strtoull(argv[++i], nullptr, 10);
+		if (strcmp(argv[i], "-solve") == 0 && i + 1 < argc) solveRoom = std::atoi(argv[++i]);
+		if (strcmp(argv[i], "-states") == 0 && i + 1 < argc) solverStates = std::atoll(argv[++i]);
+		if (strcmp(argv[i], "-playtest") == 0) {
+			int episodes = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+			playtestEpisodes = episodes > 0 ? episodes : DEFAULT_PLAYTEST_EPISODES;
+		}
+		if (strcmp(argv[i], "-agent") == 0 && i + 1 < argc)
+			playtestAgent = strcmp(argv[++i], "random") == 0 ? PlaytestAgent::RANDOM : PlaytestAgent::SEEKER;
+	}
+
+	if (playtestEpisodes > 0) {   // -playtest [episodes] [-agent seeker|random] [-j N] [-seed S]: per-room difficulty report
+		Playtester playtester(threads, playtestAgent);
+		if (!playtester.run(playtestEpisodes, fuzzSeed)) {
+			std::cout << "playtest: cannot load the game files\n";
+			return 1;
+		}
+		playtester.report(std::cout);
+		return 0;
+	}
+
+	if (solveRoom >= 0) {         // -solve <room> [-states N] [-j N]: shortest way through a room, or proof there is none
+		RoomSolver solver(threads, solverStates > 0 ? static_cast<size_t>(solverStates) : DEFAULT_SOLVER_STATES);
+		SolverResult result = solver.solve("", solveRoom);
+		RoomSolver::report(std::cout, solveRoom, result);
+		return result.solved ? 0 : 1;
+	}
+
+	if (fuzzGames > 0) {          // -fuzz [games] [-j N] [-seed S]: look for crashes on random input
+		Fuzzer fuzzer(threads, DEFAULT_FUZZ_TICKS, FUZZ_DIR);
+		if (!fuzzer.run(fuzzGames, fuzzSeed)) {
+			std::cout << "fuzz: cannot load the game files\n";
+			return 1;
+		}
+		return fuzzer.report(std::cout) == 0 ? 0 : 1;
+	}
+
+	if (verifyMode) {             // -verify [-j N]: checks the recording in parallel, one segment per checkpoint
+		ReplayRunner runner(threads);
+		ReplayResult result = runner.verifySegments(STEPS_FILE, RESULTS_FILE);
+		std::cout << (result.passed ? "Test passed" : "Test failed") << " - " << result.cycles << " cycles in "
+				  << result.segments << " segments, " << result.seconds << " s\n";
+		if (!result.error.empty())
+			std::cout << result.error << "\n";
+		return result.passed ? 0 : 1;
+	}
+
+	if (replayDir) {              // -replay <dir> [-j N]: run a whole corpus of recordings
+		ReplayRunner runner(threads);
+		if (runner.discover(replayDir) == 0) {
+			std::cout << "No replays found in " << replayDir << "\n";
+			return 1;
+		}
+		runner.runAll();
+		return runner.report(std::cout) == 0 ? 0 : 1;
 	}
 
 	if (loadMode) {
 		FileGame game(silentMode);
-		game.run();
+		if (game.isReady()) {
+			if (seekCycle >= 0)                    // -seek C: start watching from cycle C
+				game.seek(static_cast<size_t>(seekCycle));
+			else if (keyframeInterval > 0)         // -keyframes N: write keyframes while replaying
+				game.enableKeyframes(keyframeInterval);
+
+			game.run();
+			game.compareResults();
+		}
+		if (silentMode)
+			std::cout << (game.didTestPass() ? "Test passed" : "Test failed") << "\n";
+		for (const std::string& error : game.getErrors())
+			std::cout << error << "\n";
 	}
 
 	else {
 		KeyboardGame game(saveMode);
+		game.setCpuPlayer(cpuMode);
+		game.setCheckpointInterval(checkpointInterval);     // -checkpoints N: with -save, 0 for none
+		game.setHashInterval(hashInterval);                 // -hashes N: with -save, 0 for none
 		game.showMenu();
 	}
 
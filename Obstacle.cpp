@@ -1,4 +1,13 @@
 #include "Obstacle.h"
+#include "StateIO.h"
+
+uint64_t Obstacle::hashKey() const
+{
+    uint64_t h = 0;
+    for (const Point& cell : body)
+        h ^= Zobrist::key(Zobrist::OBSTACLE, Zobrist::pack(cell));
+    return h;
+}
 
 bool Obstacle::isObBody(const Point& p) const
 {                       
@@ -10,15 +19,6 @@ bool Obstacle::isObBody(const Point& p) const
 	return false;
 }
 
-bool Obstacle::canBePushed(int force) const 
-{
-    if (force < getSize())        // Not enough force to move this obstacle
-    {
-        return false;
-    }
-    return true;       // All cells can move
-}
-
 
 void Obstacle::move(Direction dir)
 {
@@ -31,13 +31,23 @@ void Obstacle::move(Direction dir)
     }
 }
 
-std::vector<Point> Obstacle::getNextBody(Direction dir) const
+void Obstacle::saveState(std::ostream& out) const
 {
-    std::vector<Point> result;
-    result.reserve(body.size());
-
+    StateIO::write(out, static_cast<uint16_t>(body.size()));
     for (const Point& cell : body)
-        result.push_back(cell.next(dir));
+        StateIO::write(out, cell);
+}
 
-    return result;
-}
\ No newline at end of file
+bool Obstacle::loadState(std::istream& in)
+{
+    uint16_t count = 0;
+    if (!StateIO::read(in, count)) return false;
+
+    body = ObstacleBody();
+    for (uint16_t i = 0; i < count; i++) {
+        Point cell;
+        if (!StateIO::read(in, cell)) return false;
+        body.push_back(cell);
+    }
+    return true;
+}
@@ -1,13 +1,19 @@
 #pragma once
 #include <vector>
+#include <iosfwd>
 #include "Point.h"
 #include "GameDefs.h"
+#include "Templates.h"
+#include "Zobrist.h"
+
+constexpr int OBSTACLE_INLINE_CELLS = 8;    // cells stored inside the obstacle itself before spilling to the heap
+
+using ObstacleBody = SmallVector<Point, OBSTACLE_INLINE_CELLS>;
 
 class Obstacle{
 private: 
 
-	std::vector<Point> body;
-	char figure = '*';
+	ObstacleBody body;
 
  public:
      // default ctor
@@ -22,16 +28,19 @@ private:
      }
 	 
      // Get Functions
-     std::vector<Point>& getBody() { return body; }    // Non-const & const access to obstacle body
-     const std::vector<Point>& getBody() const { return body; }   
+     ObstacleBody& getBody() { return body; }    // Non-const & const access to obstacle body
+     const ObstacleBody& getBody() const { return body; }   
 	 int getSize() const { return (int)body.size(); }  // casting
-     char getFigure() const { return figure; }
+     char getFigure() const { return BOARD_OBSTACLE; }
 
+     uint64_t hashKey() const;       // Zobrist key of the whole body
      bool isObBody(const Point& p) const;
-     bool canBePushed(int force) const;
+     size_t heapBytes() const { return body.heapBytes(); }
 
      void move(Direction dir);
-     std::vector<Point> getNextBody(Direction dir) const;
+
+     void saveState(std::ostream& out) const;
+     bool loadState(std::istream& in);
 
 
 };
@@ -1,4 +1,6 @@
 #include "Player.h"
+#include "Zobrist.h"
+#include "StateIO.h"
 #include <iostream>
 
 // Set Functions
@@ -11,7 +13,6 @@ void Player::setPlayer(const Point& _pos, char _figure, const char keys[6])
 	dir = forcedDir = STAY;
 	speed = 1;
 	accelTimer = 0;
-	pushing = false;
 
 	isDead = false;
 	respawnTimer = 5;
@@ -91,18 +92,6 @@ Point Player::getNextPos() const
 
 // Action Functions
 
-void Player::draw() const
-{
-	Utils::gotoxy(pos);
-	std::cout << figure;
-}
-
-void Player::erase() const
-{
-	Utils::gotoxy(pos);
-	std::cout << ' ';
-}
-
 void Player::move() {
 	Point next = getNextPos();
 
@@ -112,6 +101,14 @@ void Player::move() {
 	pos = next;
 }
 
+// Commits one resolved sub-step of the tick's movement plan.
+void Player::stepTo(const Point& p) {
+	if (p != pos)
+		afterDispose = false;
+
+	pos = p;
+}
+
 void Player::accel(int force, Direction spDir) {  // Sets forced movement
 
 	speed = force;       // speed boost and direction for several steps.
@@ -135,18 +132,19 @@ void Player::bumpedInto(Player& other) // *Logic reviewed with ChatGPT assistanc
 }
 
 
-int Player::getAccelerationSubSteps(Point subSteps[MAX_SUB_STEPS]) const
+// Cells crossed by one accelerated step taken from 'from'.
+int Player::getAccelerationSubSteps(const Point& from, Point subSteps[2]) const
 {
 	int count = 0;
 
 	// 1) forced movement (always first)
 	if (accelTimer > 0 && forcedDir != STAY)
-		subSteps[count++] = pos.next(forcedDir);
+		subSteps[count++] = from.next(forcedDir);
 
 	// 2) sideways movement (if allowed)
 	if (accelTimer > 0) {
 		if (dir != STAY && !Point::areOpposite(dir, forcedDir)) {
-			Point afterSide = subSteps[count - 1].next(dir);
+			Point afterSide = (count > 0 ? subSteps[count - 1] : from).next(dir);
 			subSteps[count++] = afterSide;
 		}
 	}
@@ -182,6 +180,18 @@ char Player::getInventoryChar() const {
 	return itemTypeToChar(inventory.type);
 }
 
+// A player is a fixed-size record, so its key is rebuilt from the fields in O(1)
+uint64_t Player::hashKey(int id) const {
+	uint64_t h = Zobrist::key(Zobrist::PLAYER, static_cast<uint64_t>(id), Zobrist::pack(pos));
+	h = Zobrist::combine(h, dir | (forcedDir << 8) | (inventory.type << 16) | (isDead << 24) |
+		(afterDispose << 25));
+	h = Zobrist::combine(h, static_cast<uint64_t>(speed) | (static_cast<uint64_t>(accelTimer) << 32));
+	h = Zobrist::combine(h, static_cast<uint64_t>(respawnTimer) | (static_cast<uint64_t>(compressedLinks) << 32));
+	h = Zobrist::combine(h, static_cast<uint64_t>(score) | (static_cast<uint64_t>(life) << 32));
+	h = Zobrist::combine(h, static_cast<uint32_t>(inventory.id) | (Zobrist::pack(teleportPos) << 32));
+	return h;
+}
+
 void Player::resetForRoom() {
 	pos = startPos;  
 	dir = STAY;         
@@ -192,10 +202,56 @@ void Player::resetForRoom() {
 
 	isDead = false;     
 	respawnTimer = 5;   
-	pushing = false;
 
 	clearInventory();
 
 	afterDispose = false;   
 }
 
+// Field by field, so the padding between them never reaches the state bytes
+void Player::saveState(std::ostream& out) const {
+	StateIO::write(out, figure);
+	StateIO::write(out, arrowKeys);
+	StateIO::write(out, pos);
+	StateIO::write(out, startPos);
+	StateIO::write(out, dir);
+	StateIO::write(out, speed);
+	StateIO::write(out, accelTimer);
+	StateIO::write(out, forcedDir);
+	StateIO::write(out, isDead);
+	StateIO::write(out, respawnTimer);
+	StateIO::write(out, afterDispose);
+	StateIO::write(out, compressedLinks);
+	StateIO::write(out, teleportPos);
+	StateIO::write(out, score);
+	StateIO::write(out, life);
+	StateIO::write(out, inventory.type);
+	StateIO::write(out, inventory.id);
+}
+
+bool Player::loadState(std::istream& in) {
+	return StateIO::read(in, figure) && StateIO::read(in, arrowKeys) && StateIO::read(in, pos) &&
+		StateIO::read(in, startPos) && StateIO::read(in, dir) && StateIO::read(in, speed) &&
+		StateIO::read(in, accelTimer) && StateIO::read(in, forcedDir) && StateIO::read(in, isDead) &&
+		StateIO::read(in, respawnTimer) && StateIO::read(in, afterDispose) && StateIO::read(in, compressedLinks) &&
+		StateIO::read(in, teleportPos) && StateIO::read(in, score) && StateIO::read(in, life) &&
+		StateIO::read(in, inventory.type) && StateIO::read(in, inventory.id);
+}
+
+void Player::dumpState(std::ostream& out, const std::string& prefix) const {
+	auto at = [](const Point& p) { return "(" + std::to_string(p.getX()) + "," + std::to_string(p.getY()) + ")"; };
+	out << prefix << "pos " << at(pos) << '\n'
+		<< prefix << "startPos " << at(startPos) << '\n'
+		<< prefix << "dir " << static_cast<int>(dir) << '\n'
+		<< prefix << "speed " << speed << '\n'
+		<< prefix << "accelTimer " << accelTimer << '\n'
+		<< prefix << "forcedDir " << static_cast<int>(forcedDir) << '\n'
+		<< prefix << "dead " << isDead << '\n'
+		<< prefix << "respawnTimer " << respawnTimer << '\n'
+		<< prefix << "afterDispose " << afterDispose << '\n'
+		<< prefix << "compressedLinks " << compressedLinks << '\n'
+		<< prefix << "teleportPos " << at(teleportPos) << '\n'
+		<< prefix << "score " << score << '\n'
+		<< prefix << "life " << life << '\n'
+		<< prefix << "item " << static_cast<int>(inventory.type) << " id=" << inventory.id << '\n';
+}
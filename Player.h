@@ -2,6 +2,8 @@
 #include "Utils.h"
 #include "Point.h"
 #include "GameDefs.h"
+#include <iosfwd>
+#include <string>
 
 class Player {
 private:
@@ -21,7 +23,6 @@ private:
 
 	bool afterDispose = false;    // True if the player disposed an item
 	int compressedLinks = 0;      // compressed links counter (spring)
-	bool pushing = false;   // player movement is constrained by obstacle push
 	Point teleportPos;
 
 	int score = 0;   
@@ -40,8 +41,6 @@ public:
 	void setDead() { isDead = true; }
 	void setDisposeFlag(bool val) { afterDispose = val; } 
 	void setTeleportPos(const Point& p) { teleportPos = p; }
-	bool isPushing() const { return pushing; }
-	void setPushing(bool v) { pushing = v; }
 
 	// Get Functions
 	Point& getPos() { return pos; }
@@ -55,9 +54,10 @@ public:
 	Point& getTeleportPos() { return teleportPos; };
 
 	// Action Functions
-	void draw() const;
+	void draw() const;             // console only (Console.cpp)
 	void erase() const;
 	void move();
+	void stepTo(const Point& p);
 	void accel(int force, Direction spDir);
 	bool isAccelerating() const { return accelTimer > 0; }
 	void stopAcceleration() {
@@ -67,27 +67,29 @@ public:
 	}
 
 	void bumpedInto(Player& otherP);
-	int getAccelerationSubSteps(Point subSteps[MAX_SUB_STEPS]) const;
+	int getAccelerationSubSteps(const Point& from, Point subSteps[2]) const;
 	void tickAcceleration();
 	void respawn();
 	char getInventoryChar() const;
+	uint64_t hashKey(int id) const;    // Zobrist key of all the player's state fields
 
 	void resetForRoom();
 
 	// Inventory Functions
 	bool inventoryEmpty() const { return inventory.type == NONE; }
 	ItemType checkItem() const { return inventory.type; }
-	int getIndex() const { return inventory.Index; }
+	int getItemId() const { return inventory.id; }
 	void clearInventory() // Removes any item the player carries.
 	{
 		inventory.type = NONE;
-		inventory.Index = -1;
+		inventory.id = -1;
 	}      
-	void collectItem(const ItemType& newItem, const int index = -1) { // Stores a new item in player's inventory  
+	void collectItem(const ItemType& newItem, const int id = -1) { // Stores a new item in player's inventory  
 		inventory.type = newItem; 
-		inventory.Index = index;   // remembers its source index
+		inventory.id = id;         // remembers which item of the room it is
 	}
 	bool isDisposeKey(char c) const { return c == arrowKeys[DISPOSE]; }  // Returns True if player pressed the Dispose key
+	char getKey(Direction d) const { return arrowKeys[d]; }   // key that moves the player in d (or disposes)
 
 	// Helper Functions for Spring handling
 	void addCompression() { compressedLinks++; }
@@ -99,6 +101,9 @@ public:
 	void addScore(const int i) { score += i; }
 	int getScore() const { return score; }
 	int getLife() const { return life; }
+	void saveState(std::ostream& out) const;    // binary state, see StateIO
+	bool loadState(std::istream& in);
+	void dumpState(std::ostream& out, const std::string& prefix) const;   // one "<name> <value>" line per field
 
 	bool lowerLife() { // no more set dead func
 		life--;
@@ -0,0 +1,208 @@
+#include "Playtester.h"
+#include "AgentEnv.h"
+#include "CpuPlayer.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <ostream>
+#include <random>
+#include <thread>
+
+constexpr int DEADLIEST_CELLS = 5;      // death cells listed per room
+constexpr int SEEKER_THINK_US = INT_MAX;    // no real deadline: the fields are always finished, so episodes don't depend on timing
+
+namespace {
+
+// An AgentEnv that also remembers where lives were lost
+class PlaytestGame : public AgentEnv {
+public:
+    std::vector<Point> deathCells;      // cleared by the caller
+
+    void onLifeLost(PlayerID id) override {
+        deathCells.push_back(players[id].getPos());
+        AgentEnv::onLifeLost(id);
+    }
+};
+
+// What one simulated player keeps between cycles
+struct AgentState {
+    int action = NO_ACTION;
+    int hold = 0;               // cycles left on the current random action
+    Point lastPos;
+    int stuck = 0;              // cycles in a row spent trying to move without moving
+};
+
+int randomAction(AgentState& s, std::mt19937_64& rng) {
+    if (--s.hold <= 0) {
+        s.hold = 1 + static_cast<int>(rng() % 12);
+        s.action = rng() % 40 == 0 ? DISPOSE : static_cast<int>(rng() % (STAY + 1));
+    }
+    int action = s.action;
+    if (action == DISPOSE) s.action = NO_ACTION;       // one press is enough
+    return action;
+}
+
+// Walks the computer player's distance fields (a key, then a door it can get through, or a switch);
+// bumping into something triggers a short random detour, and with nothing to walk to it wanders like RANDOM
+int seekerAction(const Player& player, CpuPlayer& cpu, const Screen& room, int roomID, AgentState& s, std::mt19937_64& rng) {
+    const Point& pos = player.getPos();
+    s.stuck = (pos == s.lastPos && player.getDir() != STAY) ? s.stuck + 1 : 0;
+    s.lastPos = pos;
+
+    if (s.stuck >= 2) {
+        s.stuck = 0;
+        s.hold = 3 + static_cast<int>(rng() % 8);
+        s.action = static_cast<int>(rng() % STAY);
+    }
+    if (s.hold > 0) {
+        s.hold--;
+        return s.action;
+    }
+    const Direction dir = cpu.think(room, roomID, player, SEEKER_THINK_US);     // keeps its fields in step every cycle
+    if (dir == STAY)
+        return randomAction(s, rng);
+    if (rng() % 10 == 0)
+        return static_cast<int>(rng() % STAY);
+    return dir;
+}
+
+} // namespace
+
+size_t RoomDifficulty::medianCycles() const {
+    if (exitCycles.empty()) return 0;
+    std::vector<size_t> sorted(exitCycles);
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    return sorted[sorted.size() / 2];
+}
+
+Playtester::Playtester(int threads, PlaytestAgent agentType, int cycles, const std::string& levels)
+    : numThreads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      maxCycles(cycles > 0 ? cycles : DEFAULT_PLAYTEST_CYCLES),
+      agent(agentType),
+      levelSet(levels) {
+}
+
+bool Playtester::run(int episodes, uint64_t runSeed) {
+    AgentEnv probe;
+    if (!probe.reset(levelSet)) return false;
+
+    rooms.clear();
+    results.clear();
+    for (int r = ROOM1_SCREEN; r < probe.getRoomCount(); ++r) {
+        if (!probe.enterRoom(r)) continue;
+        rooms.push_back(r);
+        results.emplace_back();
+        results.back().room = r;
+        results.back().deaths.assign(SCREEN_WIDTH * SCREEN_HEIGHT, 0);
+    }
+
+    seed = runSeed;
+    episodesPerRoom = episodes;
+    nextEpisode = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 1; t < numThreads; ++t)
+        pool.emplace_back(&Playtester::worker, this);
+    worker();                            // the calling thread works too
+    for (std::thread& th : pool)
+        th.join();
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    seconds = secs.count();
+    return true;
+}
+
+void Playtester::worker() {
+    PlaytestGame game;
+    std::vector<RoomDifficulty> local(rooms.size());
+    for (RoomDifficulty& r : local)
+        r.deaths.assign(SCREEN_WIDTH * SCREEN_HEIGHT, 0);
+
+    std::vector<CpuPlayer> seekers(NUM_PLAYERS, CpuPlayer(true));     // PlaytestGame answers riddles
+    const long long total = static_cast<long long>(rooms.size()) * episodesPerRoom;
+
+    for (long long e = nextEpisode++; e < total; e = nextEpisode++) {
+        RoomDifficulty& stats = local[e / episodesPerRoom];
+        const int room = rooms[e / episodesPerRoom];
+        const uint64_t episodeSeed = seed ^ (static_cast<uint64_t>(e) * 0x9E3779B97F4A7C15ull);
+
+        game.deathCells.clear();
+        std::mt19937_64 rng(episodeSeed);
+        AgentState agents[NUM_PLAYERS];
+        for (CpuPlayer& seeker : seekers)
+            seeker.reset();
+        stats.episodes++;
+
+        try {
+            game.reset(levelSet, episodeSeed);
+            game.enterRoom(room);
+
+            for (int t = 1; t <= maxCycles; ++t) {
+                int actions[NUM_PLAYERS];
+                for (int i = 0; i < NUM_PLAYERS; ++i) {
+                    const Player& player = game.getPlayer(i);
+                    actions[i] = agent == PlaytestAgent::SEEKER ? seekerAction(player, seekers[i], game.currentRoom(), room, agents[i], rng)
+                                                                : randomAction(agents[i], rng);
+                    if (actions[i] == player.getDir()) actions[i] = NO_ACTION;     // already moving that way
+                }
+                game.act(actions[PLAYER_1], actions[PLAYER_2]);
+
+                bool left = false;
+                for (const Results::Event& ev : game.last().events)
+                    if (ev.type == Results::SCREEN_CHANGE && ev.data1 != room) left = true;
+
+                if (left) {
+                    stats.completed++;
+                    stats.exitCycles.push_back(static_cast<size_t>(t));
+                }
+                if (left || game.last().done) break;
+            }
+        }
+        catch (const std::exception& ex) {     // a game bug - counts against the room, the run goes on
+            if (stats.crashes++ == 0) stats.firstCrash = "episode " + std::to_string(e) + ": " + ex.what();
+        }
+
+        stats.lifeLosses += static_cast<long long>(game.deathCells.size());
+        for (const Point& p : game.deathCells)
+            if (Point::checkLimits(p)) stats.deaths[p.getY() * SCREEN_WIDTH + p.getX()]++;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t r = 0; r < local.size(); ++r) {
+        RoomDifficulty& into = results[r];
+        into.episodes += local[r].episodes;
+        into.completed += local[r].completed;
+        if (into.crashes == 0) into.firstCrash = local[r].firstCrash;
+        into.crashes += local[r].crashes;
+        into.exitCycles.insert(into.exitCycles.end(), local[r].exitCycles.begin(), local[r].exitCycles.end());
+        into.lifeLosses += local[r].lifeLosses;
+        for (size_t c = 0; c < into.deaths.size(); ++c)
+            into.deaths[c] += local[r].deaths[c];
+    }
+}
+
+void Playtester::report(std::ostream& out) const {
+    out << "Playtest: " << episodesPerRoom << " episodes per room, "
+        << (agent == PlaytestAgent::SEEKER ? "seeker" : "random") << " agents, "
+        << maxCycles << " cycles max, " << numThreads << " threads, " << seconds << " s\n";
+
+    for (const RoomDifficulty& r : results) {
+        out << "Room " << r.room << ": " << static_cast<int>(r.completionRate() * 1000) / 10.0 << "% completed";
+        if (r.completed > 0)
+            out << ", median " << r.medianCycles() << " cycles to exit";
+        out << ", " << (r.episodes ? static_cast<double>(r.lifeLosses) / r.episodes : 0) << " lives lost per episode\n";
+        if (r.crashes > 0)
+            out << "  " << r.crashes << " episodes crashed, first " << r.firstCrash << '\n';
+
+        std::vector<int> cells;
+        for (int c = 0; c < static_cast<int>(r.deaths.size()); ++c)
+            if (r.deaths[c] > 0) cells.push_back(c);
+        if (cells.empty()) continue;
+
+        std::sort(cells.begin(), cells.end(), [&r](int a, int b) { return r.deaths[a] > r.deaths[b]; });
+        out << "  deadliest cells:";
+        for (int i = 0; i < std::min<int>(DEADLIEST_CELLS, static_cast<int>(cells.size())); ++i)
+            out << " (" << cells[i] % SCREEN_WIDTH << ',' << cells[i] / SCREEN_WIDTH << ") x" << r.deaths[cells[i]];
+        out << '\n';
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "GameDefs.h"
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <vector>
+
+constexpr int DEFAULT_PLAYTEST_EPISODES = 1000;     // episodes per room
+constexpr int DEFAULT_PLAYTEST_CYCLES = 3000;       // an episode that hasn't left the room by then counts as failed
+
+// How the simulated players choose their keys
+enum class PlaytestAgent {
+    RANDOM,         // holds a random direction for a while, now and then drops what it carries
+    SEEKER          // walks CpuPlayer's distance fields to a key, a door or a switch, with some noise
+};
+
+// Difficulty numbers of one room, over all its episodes
+struct RoomDifficulty {
+    int room = 0;
+    int episodes = 0;
+    int completed = 0;                  // a player went through a door
+    int crashes = 0;                    // episodes the game threw on - failed, not completed
+    std::string firstCrash;             // "episode <n>: <what>" of the first one
+    std::vector<size_t> exitCycles;     // cycle each completed episode left the room on
+    long long lifeLosses = 0;
+    std::vector<int> deaths;            // [y * SCREEN_WIDTH + x] - lives lost on each cell
+
+    double completionRate() const { return episodes ? static_cast<double>(completed) / episodes : 0; }
+    size_t medianCycles() const;
+};
+
+// Monte Carlo playtesting: thousands of headless episodes in every room, played by simulated agents
+// on a fixed pool of worker threads. Each episode drops both players into the room on fresh lives and
+// runs until one of them leaves through a door, the game ends or the cycle limit is reached.
+// Unlike RoomSolver this says how hard a room is to stumble through, not whether it can be done.
+class Playtester {
+private:
+    int numThreads;
+    int maxCycles;
+    PlaytestAgent agent;
+    std::string levelSet;
+    uint64_t seed = 0;
+    int episodesPerRoom = 0;
+    double seconds = 0;
+
+    std::vector<int> rooms;                 // playable rooms, in report order
+    std::atomic<long long> nextEpisode{0};
+
+    std::mutex mutex;                       // guards results
+    std::vector<RoomDifficulty> results;
+
+    void worker();
+
+public:
+    Playtester(int threads, PlaytestAgent agentType, int cycles = DEFAULT_PLAYTEST_CYCLES, const std::string& levels = "");
+
+    bool run(int episodes, uint64_t runSeed);       // false if the level files can't be loaded
+    const std::vector<RoomDifficulty>& getResults() const { return results; }
+    void report(std::ostream& out) const;
+};
@@ -1,9 +1,10 @@
 #include "Player.h"
 
 bool Point::checkLimits(const Point& p) {
-	int x = p.getX();
-	int y = p.getY();
+	return checkLimits(p.getX(), p.getY());
+}
 
+bool Point::checkLimits(int x, int y) {
 	// Returns true if the given point lies inside the screen boundaries.
 	return (x >= 0 && x < SCREEN_WIDTH
 		&&	y >= 0 && y < SCREEN_HEIGHT);
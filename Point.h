@@ -2,14 +2,16 @@
 #include "GameDefs.h"
 
 // Represents a 2D position on the screen/board.
+// Both coordinates are packed into 16 bits - the board is 80x25, and the
+// few off-board points the game uses (blast rays, teleport "none") stay tiny.
 class Point {
 private:
-	int x, y;   // coordinates
+	int8_t x, y;   // coordinates
 
 public:
 	Point() { x = y = 0; };
 
-	Point(const int _x, const int _y) : x(_x), y(_y) {};
+	Point(const int _x, const int _y) : x(static_cast<int8_t>(_x)), y(static_cast<int8_t>(_y)) {};
 
 	bool operator==(const Point& other) const {
 		return x == other.x && y == other.y;
@@ -29,7 +31,11 @@ public:
 
 	Point next(Direction dir) const;             // Returns the next position when moving one step in the given direction.
 	static bool checkLimits(const Point& p);     // Checks whether a point is inside the screen limits. 
+	static bool checkLimits(int x, int y);       // Same, for coordinates that may not fit in a Point yet.
 	static bool areOpposite(Direction d1, Direction d2);   // Returns true if two directions are opposite to each other.
 	static Direction opposite(Direction dir);
 
 };
+
+static_assert(MAX_X + BOMB_BLAST_RADIUS < INT8_MAX && MAX_Y + BOMB_BLAST_RADIUS < INT8_MAX,
+	"Board coordinates must fit in a packed Point");
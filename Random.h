@@ -0,0 +1,29 @@
+#pragma once
+#include "Zobrist.h"
+#include <cstdint>
+
+// File: Random.h
+// Description:
+//   Counter-based random numbers for the game's random choices.
+//   A draw is a pure function of (seed, stream, counter) - there is no generator state to carry,
+//   snapshot or rewind, so a replay reproduces every draw from the seed recorded in its steps file,
+//   and game instances running side by side never share anything.
+//   Each random element of the game draws from its own stream, so adding one doesn't shift the others.
+//   Built on the same SplitMix64 finalizer as the Zobrist keys.
+
+namespace Random {
+
+    inline uint64_t draw(uint64_t seed, uint64_t stream, uint64_t counter) {
+        return Zobrist::combine(Zobrist::mix(seed ^ (stream * 0xD1B54A32D192ED03ULL)), counter);
+    }
+
+    // Uniform in [0, bound) (multiply-shift on the high 32 bits; bound 0 gives 0)
+    inline uint32_t below(uint64_t value, uint32_t bound) {
+        return static_cast<uint32_t>(((value >> 32) * bound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    inline double unit(uint64_t value) {
+        return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+    }
+}
@@ -0,0 +1,180 @@
+#include "ReplayRunner.h"
+#include "FileGame.h"
+#include "HeadlessGame.h"
+#include "Keyframes.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+ReplayRunner::ReplayRunner(int threads)
+    : numThreads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+int ReplayRunner::discover(const std::string& dir) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<Replay> found;
+
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        fs::path stepsPath = entry.path();
+        if (stepsPath.extension() != STEPS_EXT) continue;
+
+        fs::path resultsPath = stepsPath;
+        resultsPath.replace_extension(RESULTS_EXT);
+        if (fs::exists(resultsPath))          // a replay needs both halves
+            found.push_back({ stepsPath.string(), resultsPath.string() });
+    }
+
+    // Directory order is unspecified - keep reports stable between runs
+    std::sort(found.begin(), found.end(),
+              [](const Replay& a, const Replay& b) { return a.stepsFile < b.stepsFile; });
+
+    replays.insert(replays.end(), found.begin(), found.end());
+    return static_cast<int>(found.size());
+}
+
+ReplayResult ReplayRunner::runOne(const Replay& replay) const {
+    auto start = std::chrono::steady_clock::now();
+
+    ReplayResult result;
+    result.name = replay.stepsFile;
+
+    FileGame game(true, replay.stepsFile, replay.resultsFile);   // isolated, silent game
+    bool crashed = false;
+    if (game.isReady()) {
+        try {
+            game.run();
+            game.compareResults();
+        }
+        catch (const std::exception& e) {      // e.g. a saved fuzzer find - one replay must not end the whole run
+            crashed = true;
+            result.error = std::string("Exception: ") + e.what();
+        }
+    }
+    result.passed = game.isReady() && !crashed && game.didTestPass();
+    result.cycles = game.getCycles();
+    if (!crashed && !game.getErrors().empty())
+        result.error = game.getErrors().front();
+
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    result.seconds = secs.count();
+    return result;
+}
+
+// Workers take the next unclaimed replay until none are left; every result lands in its own slot
+void ReplayRunner::runAll() {
+    results.assign(replays.size(), ReplayResult());
+    std::atomic<size_t> next(0);
+
+    auto worker = [this, &next]() {
+        for (size_t i = next++; i < replays.size(); i = next++)
+            results[i] = runOne(replays[i]);
+    };
+
+    int count = std::min<int>(numThreads, static_cast<int>(replays.size()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < count; t++)
+        pool.emplace_back(worker);
+    worker();                       // the calling thread works too
+    for (std::thread& th : pool)
+        th.join();
+}
+
+// Without checkpoints this is a plain single-thread replay. Every segment gets its own silent
+// FileGame; the checkpoint a segment has to reach is loaded into a scratch game for its stateHash.
+ReplayResult ReplayRunner::verifySegments(const std::string& stepsFile, const std::string& resultsFile) const {
+    std::vector<Keyframe> frames;
+    if (!Keyframes::readAll(Keyframes::fileFor(stepsFile), frames) || frames.empty())
+        return runOne({ stepsFile, resultsFile });
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t segments = frames.size() + 1;
+    std::vector<std::string> errors(segments);
+    std::vector<size_t> cycles(segments);
+    std::atomic<size_t> next(0);
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < segments; i = next++) {
+            const Keyframe* from = i > 0 ? &frames[i - 1] : nullptr;
+            const Keyframe* to = i < frames.size() ? &frames[i] : nullptr;
+
+            uint64_t endHash = 0;
+            if (to) {
+                HeadlessGame scratch;
+                std::istringstream frame(to->payload);
+                if (!scratch.load()) {
+                    errors[i] = scratch.getLastError();
+                    continue;
+                }
+                if (!scratch.loadState(frame)) {
+                    errors[i] = "Corrupt checkpoint at cycle " + std::to_string(to->cycle);
+                    continue;
+                }
+                endHash = scratch.stateHash();
+            }
+
+            FileGame game(true, stepsFile, resultsFile);
+            try {
+                if (game.isReady()) game.verifySegment(from, to, endHash);
+            }
+            catch (const std::exception& e) {
+                errors[i] = std::string("Exception: ") + e.what();
+                continue;
+            }
+            if (!game.isReady() || !game.didTestPass())
+                errors[i] = game.getErrors().empty() ? "Replay could not be loaded" : game.getErrors().front();
+            cycles[i] = game.getCycles();
+        }
+    };
+
+    int count = std::min<int>(numThreads, static_cast<int>(segments));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < count; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& th : pool)
+        th.join();
+
+    ReplayResult result;
+    result.name = stepsFile;
+    result.segments = segments;
+    result.cycles = cycles.back();
+    auto failed = std::find_if(errors.begin(), errors.end(), [](const std::string& e) { return !e.empty(); });
+    result.passed = failed == errors.end();
+    if (!result.passed)
+        result.error = *failed;      // the earliest segment that went wrong
+
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    result.seconds = secs.count();
+    return result;
+}
+
+int ReplayRunner::report(std::ostream& out) const {
+    int failed = 0;
+    size_t totalCycles = 0;
+    double totalSeconds = 0;
+
+    for (const ReplayResult& r : results) {
+        out << (r.passed ? "PASS  " : "FAIL  ") << r.name
+            << "  cycles: " << r.cycles
+            << "  time: " << std::fixed << std::setprecision(3) << r.seconds << "s";
+        if (!r.error.empty())
+            out << "  (" << r.error << ")";
+        out << '\n';
+
+        failed += r.passed ? 0 : 1;
+        totalCycles += r.cycles;
+        totalSeconds += r.seconds;
+    }
+
+    out << results.size() - failed << "/" << results.size() << " replays passed, "
+        << totalCycles << " cycles, " << std::fixed << std::setprecision(3) << totalSeconds
+        << "s of replay time on " << numThreads << " threads\n";
+    return failed;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+// Outcome of replaying one recorded session
+struct ReplayResult {
+    std::string name;       // steps file the replay was read from
+    bool passed = false;
+    size_t cycles = 0;
+    double seconds = 0;     // wall time of this replay
+    std::string error;      // first reported problem, empty if passed
+    size_t segments = 1;    // stretches verified independently (checkpoints + 1)
+};
+
+// Runs a corpus of recorded sessions (<name>.steps + <name>.results pairs), each in its own
+// silent FileGame, spread over a fixed pool of worker threads.
+class ReplayRunner {
+private:
+    struct Replay {
+        std::string stepsFile;
+        std::string resultsFile;
+    };
+
+    std::vector<Replay> replays;
+    std::vector<ReplayResult> results;     // same order as replays
+    int numThreads;
+
+    ReplayResult runOne(const Replay& replay) const;
+
+public:
+    explicit ReplayRunner(int threads);
+
+    int discover(const std::string& dir);    // adds every pair found in dir, returns how many
+    void runAll();
+
+    // One recording split at its checkpoints (<name>.keyframes), every stretch replayed on its own
+    // thread. Each stretch has to end in the state of the checkpoint after it.
+    ReplayResult verifySegments(const std::string& stepsFile, const std::string& resultsFile) const;
+    int report(std::ostream& out) const;     // prints per-replay lines and a summary, returns failures
+};
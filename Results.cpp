@@ -1,17 +1,37 @@
-#include <limits>
 #include <fstream>
+#include <sstream>
 #include "Results.h"
 
 Results Results::loadResults(const std::string& filename) {
+    // Reads the format written by saveResults: event count, then one event per line
     std::ifstream results_file(filename);
     Results results;
-    size_t size;
+    size_t size = 0;
     results_file >> size;
-    while (!results_file.eof() && size-- != 0) {
-        size_t iteration;
-        int result;
-        results_file >> iteration >> result;
-        results.addResult(iteration, static_cast<ResultValue>(result));
+
+    while (size-- != 0) {
+        size_t cycle;
+        std::string tag;
+        if (!(results_file >> cycle >> tag)) break;
+
+        int player = PLAYER_1, a = 0, b = 0;
+        if (tag == "SCREEN") {
+            results_file >> player >> a;
+            results.addScreenChange(cycle, static_cast<PlayerID>(player), a);
+        }
+        else if (tag == "LIFE") {
+            results_file >> player;
+            results.addLifeLost(cycle, static_cast<PlayerID>(player));
+        }
+        else if (tag == "RIDDLE") {
+            results_file >> player >> a;
+            results.addRiddle(cycle, static_cast<PlayerID>(player), a != 0);
+        }
+        else if (tag == "END") {
+            results_file >> a >> b;
+            results.addGameEnd(cycle, a, b);
+        }
+        else break;     // unknown event - stop reading
     }
     return results;
 }
@@ -21,42 +41,53 @@ void Results::saveResults(const std::string& filename) const {
     file << events.size() << '\n';
 
     for (const auto& e : events) {
-        switch (e.type) {
-            case SCREEN_CHANGE:
-                // cycle SCREEN player room
-                file << e.cycle << " SCREEN " << e.player << ' ' << e.data1 << '\n';
-                break;
-            case LIFE_LOST:
-                // cycle LIFE player
-                file << e.cycle << " LIFE " << e.player << '\n';
-                break;
-            case RIDDLE_ANSWERED:
-                // cycle RIDDLE player correct
-                file << e.cycle << " RIDDLE " << e.player << ' ' << e.correct << '\n';
-                break;
-            case GAME_END:
-                // cycle END score1 score2
-                file << e.cycle << " END " << e.data1 << ' ' << e.data2 << '\n';
-                break;
-        }
+        writeEvent(file, e);
+        file << '\n';
     }
     file.close();
 }
 
-/*void Results::saveResults(const std::string& filename) {
-    std::ofstream results_file(filename);
-    results_file << results.size();
-    for (const auto& result : results) {
-        results_file << '\n' << result.first << ' ' << result.second;
+void Results::writeEvent(std::ostream& out, const Event& e) {
+    switch (e.type) {
+        case SCREEN_CHANGE:
+            // cycle SCREEN player room
+            out << e.cycle << " SCREEN " << e.player << ' ' << e.data1;
+            break;
+        case LIFE_LOST:
+            // cycle LIFE player
+            out << e.cycle << " LIFE " << e.player;
+            break;
+        case RIDDLE_ANSWERED:
+            // cycle RIDDLE player correct
+            out << e.cycle << " RIDDLE " << e.player << ' ' << e.correct;
+            break;
+        case GAME_END:
+            // cycle END score1 score2
+            out << e.cycle << " END " << e.data1 << ' ' << e.data2;
+            break;
     }
-    results_file.close();
-}*/
+}
 
-size_t Results::getNextBombIteration() {
-    if (!results.empty() && results.front().second == hitBomb)
-        return results.front().first;
+std::string Results::describe(const Event& e) {
+    std::ostringstream out;
+    writeEvent(out, e);
+    return out.str();
+}
 
-    return std::numeric_limits<size_t>::max(); // a big number we will never reach
+bool Results::hasNoMoreRiddles() const {
+    for (size_t i = riddleCursor; i < events.size(); i++) {
+        if (events[i].type == RIDDLE_ANSWERED)
+            return false;
+    }
+    return true;
 }
 
-;
+bool Results::getNextRiddleResult() {
+    // The cursor only moves forward, so handing out all answers costs one pass over the events
+    while (riddleCursor < events.size()) {
+        const Event& e = events[riddleCursor++];
+        if (e.type == RIDDLE_ANSWERED)
+            return e.correct;
+    }
+    return false;
+}
@@ -1,6 +1,7 @@
 #pragma once
-#include <list>
+#include <vector>
 #include <string>
+#include <iosfwd>
 //#include <fstream>
 #include "GameDefs.h"
 
@@ -15,16 +16,32 @@ public:
         int data1;       // room number / score1
         int data2;       // score2 (for GAME_END)
         bool correct;    // for RIDDLE
+
+        bool operator==(const Event& other) const {
+            return cycle == other.cycle && type == other.type && player == other.player
+                && data1 == other.data1 && data2 == other.data2 && correct == other.correct;
+        }
+        bool operator!=(const Event& other) const { return !(*this == other); }
     };
 
 private:
-    std::list<Event> events;
+    std::vector<Event> events;
+    size_t cursor = 0;           // next event to be consumed by popEvent (replay side)
+    size_t riddleCursor = 0;     // next event to look at for a riddle answer
 
 public:
     static Results loadResults(const std::string& filename);
 
     void saveResults(const std::string &filename) const;
 
+    static void writeEvent(std::ostream& out, const Event& e);   // one event in the file's line format
+    static std::string describe(const Event& e);
+
+    const std::vector<Event>& getEvents() const { return events; }
+    const Event& lastEvent() const { return events.back(); }
+    size_t size() const { return events.size(); }
+    size_t getLastCycle() const { return events.empty() ? 0 : events.back().cycle; }
+
     /*void addResult(size_t iteration, EventType type) {
         events.emplace_back(Event{iteration, type, PLAYER_1, 0, 0, false});
     }*/
@@ -45,36 +62,26 @@ public:
         events.push_back({cycle, GAME_END, PLAYER_1, score1, score2, false});
     }
 
-    bool hasMoreEvents() const { return !events.empty(); }
+    // Cursor over the events, in recorded order
+    bool hasMoreEvents() const { return cursor < events.size(); }
 
     Event peekEvent() const {
-        return events.empty() ? Event{0, GAME_END, PLAYER_1, 0, 0, false} : events.front();
+        return hasMoreEvents() ? events[cursor] : Event{0, GAME_END, PLAYER_1, 0, 0, false};
     }
 
     Event popEvent() {
-        if (events.empty()) return {0, GAME_END, PLAYER_1, 0, 0, false};
-        Event e = events.front();
-        events.pop_front();
-        return e;
+        if (!hasMoreEvents()) return {0, GAME_END, PLAYER_1, 0, 0, false};
+        return events[cursor++];
     }
 
-    bool getNextRiddleResult() {
-        for (auto& e : events) {
-            if (e.type == RIDDLE_ANSWERED) {
-                return e.correct;
-            }
-        }
-        return false;
+    void skipUntil(size_t cycle) {       // moves both cursors to the first event after cycle
+        cursor = 0;
+        while (hasMoreEvents() && events[cursor].cycle <= cycle)
+            cursor++;
+        riddleCursor = cursor;
     }
 
-    static std::pair<size_t, ResultValue> popResult() {
-        if (results.empty()) return { 0, Results::noResult };
-        auto result = results.front();
-        results.pop_front();
-        return result;
-    }
-    static bool isFinishedBy(size_t iteration) {
-        return results.empty() || results.back().first <= iteration;
-    }
-    static size_t getNextBombIteration() ;
+    // Recorded riddle answers, in the order they were given
+    bool hasNoMoreRiddles() const;
+    bool getNextRiddleResult();
 };
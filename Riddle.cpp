@@ -1,4 +1,5 @@
 #include "Riddle.h"
+#include "StateIO.h"
 
 void Riddle::setData(const std::string& q, const std::string& a)
 {
@@ -6,69 +7,16 @@ void Riddle::setData(const std::string& q, const std::string& a)
     answer = a;
 }
 
-void Riddle::printUI() const { //function helped by GEMINI
-    constexpr char BORDER = '?';
-    const int INDENT = 8;
-    const int WIDTH = (std::max)(static_cast<int>(question.length()) + 4, 44);
-
-    auto printRow = [&](std::string const& text = "", bool isLeftAlign = false) {
-        int textLen = static_cast<int>(text.length());
-        int padding = WIDTH - 2 - textLen;
-
-        int padLeft = isLeftAlign ? 1 : padding / 2;
-        int padRight = padding - padLeft;
-
-        std::cout << std::string(INDENT, ' ') << BORDER
-            << std::string(padLeft, ' ') << text << std::string(padRight, ' ')
-            << BORDER << "\n";
-        };
-
-    std::cout << "\n\n";
-    std::cout << std::string(INDENT, ' ') << std::string(WIDTH, BORDER) << "\n";
-    printRow();
-    printRow(question);
-    printRow();
-    printRow("Answer: ", true);
-    std::cout << std::string(INDENT, ' ') << std::string(WIDTH, BORDER) << "\n";
-
-    std::string prompt = "Answer: ";
-    int promptLen = static_cast<int>(prompt.length());
-
-    Utils::gotoxy(INDENT + 1 + 1 + promptLen, 6);
+void Riddle::saveState(std::ostream& out) const
+{
+    StateIO::write(out, pos);
+    StateIO::write(out, solved);
+    StateIO::writeString(out, question);
+    StateIO::writeString(out, answer);
 }
 
-bool Riddle::solve() { // need to be changed
-    if (solved) return true;
-
-    printUI(); // what about silent mode?
-
-    std::string input;
-    std::cin >> input;
-
-    std::string cleanInput = Utils::toUpperCase(input);
-    std::string cleanAnswer = Utils::toUpperCase(answer);
-
-    std::string formattedAnswer = "|" + cleanAnswer + "|";
-    std::string formattedInput = "|" + cleanInput + "|";
-
-    bool isCorrect = (formattedAnswer.find(formattedInput) != std::string::npos);
-
-    int feedbackRow = 8;
-    int indent = 8;
-    Utils::gotoxy(indent, feedbackRow);
-
-    if (isCorrect) {
-        std::cout << ">>> CORRECT! You may pass. <<<";
-        solved = true;
-    }
-    else
-        std::cout << ">>> WRONG! You shall NOT pass. <<<";
-
-    Utils::gotoxy(indent, feedbackRow + 1);
-    std::cout << "Press ENTER to continue...";
-
-    std::cin.ignore();
-    std::cin.get();
-
-    return solved;
-}
\ No newline at end of file
+bool Riddle::loadState(std::istream& in)
+{
+    return StateIO::read(in, pos) && StateIO::read(in, solved)
+        && StateIO::readString(in, question) && StateIO::readString(in, answer);
+}
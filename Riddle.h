@@ -1,6 +1,7 @@
 #pragma once
 #include "Point.h"
 #include "Utils.h"
+#include "Zobrist.h"
 #include <string>
 #include <iostream>
 #include <utility>
@@ -10,7 +11,6 @@
 class Riddle {
 private:
     Point pos;
-    char figure = '?';
     std::string question;
     std::string answer;
     bool solved = false;
@@ -27,9 +27,14 @@ public:
 
     void setData(const std::string& q, const std::string& a);
     Point getPos() const { return pos; }
-    char getFigure() const { return figure; }
+    char getFigure() const { return BOARD_RIDDLE; }
     bool isSolved() const { return solved; }
+    uint64_t hashKey() const { return Zobrist::key(Zobrist::RIDDLE, Zobrist::pack(pos), solved); }   // Zobrist key of this record
 
-    bool solve();
+    bool solve();       // asks on the console (Console.cpp)
+    size_t heapBytes() const { return question.capacity() + answer.capacity(); }   // upper bound - short strings stay inline
+
+    void saveState(std::ostream& out) const;
+    bool loadState(std::istream& in);
 
 };
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "RoomSolver.h"
+#include "AgentEnv.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+constexpr int NUM_JOINT_ACTIONS = NUM_AGENT_ACTIONS * NUM_AGENT_ACTIONS;
+constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+// Lock-free set of 64-bit state hashes (open addressing, linear probing, never shrinks)
+class StateTable {
+private:
+    std::vector<std::atomic<uint64_t>> slots;
+    size_t mask;
+
+public:
+    explicit StateTable(size_t states) {
+        size_t capacity = 1024;
+        while (capacity < states * 2) capacity <<= 1;      // at most half full
+        slots = std::vector<std::atomic<uint64_t>>(capacity);
+        mask = capacity - 1;
+    }
+
+    bool insert(uint64_t h) {      // true if h wasn't in the table yet
+        if (h == 0) h = 1;          // 0 marks an empty slot
+        for (size_t i = h & mask; ; i = (i + 1) & mask) {
+            uint64_t current = slots[i].load(std::memory_order_relaxed);
+            if (current == h) return false;
+            if (current == 0) {
+                if (slots[i].compare_exchange_strong(current, h)) return true;
+                if (current == h) return false;     // another thread got there first with the same state
+            }
+        }
+    }
+};
+
+// Search tree: only the parent link and the joint action are kept for every state
+struct Node {
+    uint32_t parent;
+    uint8_t action;             // action of player 1 * NUM_AGENT_ACTIONS + action of player 2
+};
+
+struct FrontierEntry {
+    GameSnapshot snap;
+    uint32_t node;
+};
+
+struct Expansion {              // new state found while expanding a level, numbered when levels merge
+    GameSnapshot snap;
+    uint32_t parent;
+    uint8_t action;
+};
+
+} // namespace
+
+RoomSolver::RoomSolver(int threads, size_t states)
+    : numThreads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      maxStates(states > 0 ? states : DEFAULT_SOLVER_STATES) {
+}
+
+// One BFS from start. actors is a bit mask of the players allowed to press keys; the others press nothing.
+// Only solutions of at most maxTicks cycles are looked for.
+static SolverResult search(std::vector<std::unique_ptr<AgentEnv>>& games, const GameSnapshot& start,
+                           int actors, int targetRoom, size_t maxStates, size_t maxTicks = SIZE_MAX) {
+    SolverResult result;
+    result.actors = actors;
+    const int numThreads = static_cast<int>(games.size());
+    const bool alone = actors != ((1 << PLAYER_1) | (1 << PLAYER_2));
+
+    AgentEnv& root = *games[0];
+    root.restore(start);
+
+    StateTable table(maxStates);
+    table.insert(root.stateHash());
+    std::atomic<size_t> states(1);
+    std::atomic<bool> limitHit(false);
+    std::atomic<bool> lifeLossPruned(false);
+
+    std::vector<Node> nodes{ { NO_PARENT, 0 } };
+    std::vector<FrontierEntry> frontier{ { start, 0 } };
+
+    std::mutex foundMutex;
+    bool found = false;
+    std::atomic<bool> stop(false);
+    uint32_t foundParent = NO_PARENT;
+    uint8_t foundAction = 0;
+
+    // Workers take frontier states one at a time and try every joint action on each
+    auto expand = [&](AgentEnv& g, std::vector<Expansion>& out, std::atomic<size_t>& next) {
+        for (size_t i = next++; i < frontier.size() && !stop; i = next++) {
+            const FrontierEntry& entry = frontier[i];
+
+            // Actions that change nothing are the same as pressing nothing: the key of the direction
+            // the player already moves in, and dispose with an empty inventory. A player on its own
+            // only ever needs to drop a bomb - anything else it drops it can only pick up again, and
+            // every cell it could drop a key on multiplies the states.
+            bool useful[NUM_PLAYERS][NUM_AGENT_ACTIONS];
+            for (int p = 0; p < NUM_PLAYERS; ++p) {
+                const Player& player = entry.snap.players[p];
+                const bool acts = (actors >> p) & 1;
+                const bool canDrop = alone ? player.checkItem() == BOMB : !player.inventoryEmpty();
+                for (int act = 0; act < NUM_AGENT_ACTIONS; ++act)
+                    useful[p][act] = act == NO_ACTION ||
+                        (acts && (act == DISPOSE ? canDrop : act != player.getDir()));
+            }
+
+            for (int a = 0; a < NUM_JOINT_ACTIONS; ++a) {
+                if (!useful[PLAYER_1][a / NUM_AGENT_ACTIONS] || !useful[PLAYER_2][a % NUM_AGENT_ACTIONS])
+                    continue;
+
+                g.restore(entry.snap);
+                g.act(a / NUM_AGENT_ACTIONS, a % NUM_AGENT_ACTIONS);
+
+                bool lifeLost = false;
+                int reached = -1;
+                for (const Results::Event& e : g.last().events) {
+                    if (e.type == Results::LIFE_LOST) lifeLost = true;
+                    if (e.type == Results::SCREEN_CHANGE && (targetRoom < 0 || e.data1 == targetRoom))
+                        reached = e.data1;
+                }
+
+                if (reached >= 0) {
+                    std::lock_guard<std::mutex> lock(foundMutex);
+                    if (!found) {       // every solution on this level is equally short
+                        found = true;
+                        foundParent = entry.node;
+                        foundAction = static_cast<uint8_t>(a);
+                        result.reachedRoom = reached;
+                    }
+                    stop = true;
+                    break;
+                }
+                if (lifeLost) lifeLossPruned = true;
+                if (lifeLost || g.isOver()) continue;
+
+                if (states >= maxStates) {
+                    limitHit = true;
+                    continue;
+                }
+                if (!table.insert(g.stateHash())) continue;     // seen before, on this level or an earlier one
+                states++;
+                out.push_back({ g.snapshot(), entry.node, static_cast<uint8_t>(a) });
+            }
+        }
+    };
+
+    for (size_t depth = 0; !frontier.empty() && !found && depth < maxTicks; ++depth) {
+        std::atomic<size_t> next(0);
+        std::vector<std::vector<Expansion>> expansions(numThreads);
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < numThreads; ++t)
+            pool.emplace_back(expand, std::ref(*games[t]), std::ref(expansions[t]), std::ref(next));
+        expand(*games[0], expansions[0], next);           // the calling thread works too
+        for (std::thread& th : pool)
+            th.join();
+
+        std::vector<FrontierEntry> nextFrontier;
+        for (std::vector<Expansion>& part : expansions) {
+            for (Expansion& e : part) {
+                nextFrontier.push_back({ std::move(e.snap), static_cast<uint32_t>(nodes.size()) });
+                nodes.push_back({ e.parent, e.action });
+            }
+        }
+        frontier = std::move(nextFrontier);
+    }
+
+    result.states = states;
+    result.lifeLossPruned = lifeLossPruned;
+    result.exhausted = !limitHit;
+    if (found) {
+        std::vector<uint8_t> actions{ foundAction };
+        for (uint32_t n = foundParent; nodes[n].parent != NO_PARENT; n = nodes[n].parent)
+            actions.push_back(nodes[n].action);
+        std::reverse(actions.begin(), actions.end());
+
+        result.solved = true;
+        result.shortest = !limitHit;            // BFS - nothing shorter was skipped
+        result.ticks = actions.size();
+        for (size_t t = 0; t < actions.size(); ++t) {
+            const int perPlayer[NUM_PLAYERS] = { actions[t] / NUM_AGENT_ACTIONS, actions[t] % NUM_AGENT_ACTIONS };
+            for (int i = 0; i < NUM_PLAYERS; ++i) {
+                if (perPlayer[i] != NO_ACTION)
+                    result.inputs.emplace_back(t + 1, start.players[i].getKey(static_cast<Direction>(perPlayer[i])));
+            }
+        }
+    }
+    return result;
+}
+
+// Each player alone first - a far smaller search, and enough for most rooms. A player alone can miss a
+// shorter way that needs both, so its solution only bounds the joint search, which proves it par or
+// finds a shorter one. Only when neither can get through alone, and both searches covered everything,
+// are both players searched without a bound. Only the joint search is complete, so only it can prove
+// a room unsolvable or a solution shortest.
+SolverResult RoomSolver::solve(const std::string& levelSet, int roomID, const Point startCells[NUM_PLAYERS],
+                               int targetRoom) const {
+    auto startTime = std::chrono::steady_clock::now();
+    SolverResult result;
+
+    std::vector<std::unique_ptr<AgentEnv>> games;
+    for (int t = 0; t < numThreads; ++t)
+        games.push_back(std::make_unique<AgentEnv>());
+
+    AgentEnv& root = *games[0];
+    if (!root.reset(levelSet)) {
+        result.error = "Cannot load the level files: " + root.getLastError();
+        return result;
+    }
+    if (!root.enterRoom(roomID, startCells)) {
+        result.error = "Room " + std::to_string(roomID) + " can't be solved (not a playable room)";
+        return result;
+    }
+    const GameSnapshot start = root.snapshot();
+
+    const int both = (1 << PLAYER_1) | (1 << PLAYER_2);
+    size_t states = 0;
+    bool allExhausted = true;
+    for (int actors : { 1 << PLAYER_1, 1 << PLAYER_2 }) {
+        SolverResult alone = search(games, start, actors, targetRoom, maxStates);
+        states += alone.states;
+        allExhausted = allExhausted && alone.exhausted;
+        if (alone.solved && (!result.solved || alone.ticks < result.ticks))
+            result = alone;
+    }
+    if (result.solved) {
+        SolverResult joint = search(games, start, both, targetRoom, maxStates, result.ticks - 1);
+        states += joint.states;
+        if (joint.solved)
+            result = joint;
+        else {
+            result.shortest = joint.exhausted;      // every joint input shorter than it was tried
+            result.lifeLossPruned = joint.lifeLossPruned;
+        }
+    }
+    else if (allExhausted) {
+        result = search(games, start, both, targetRoom, maxStates);
+        states += result.states;
+    }
+
+    result.states = states;
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - startTime;
+    result.seconds = secs.count();
+    return result;
+}
+
+SolverResult RoomSolver::solve(const std::string& levelSet, int roomID, int targetRoom) const {
+    Point startCells[NUM_PLAYERS];
+    for (int i = 0; i < NUM_PLAYERS; ++i)
+        startCells[i] = Point(PLAYER_START_X[i], PLAYER_START_Y[i]);
+    return solve(levelSet, roomID, startCells, targetRoom);
+}
+
+void RoomSolver::report(std::ostream& out, int roomID, const SolverResult& result) {
+    if (!result.error.empty()) {
+        out << result.error << '\n';
+        return;
+    }
+
+    out << "Room " << roomID << ": ";
+    if (result.solved) {
+        out << "solved - " << (result.shortest ? "par " : "") << result.ticks << " cycles"
+            << (result.shortest ? "" : " (upper bound - no proof that nothing shorter exists)")
+            << (result.shortest && result.lifeLossPruned ? " without losing a life" : "")
+            << ", reaches room " << result.reachedRoom
+            << (result.actors == (1 << PLAYER_1) ? " (player 1 alone)" :
+                result.actors == (1 << PLAYER_2) ? " (player 2 alone)" : " (both players)") << '\n'
+            << "inputs (cycle:key):";
+        for (const auto& step : result.inputs)
+            out << ' ' << step.first << ':' << step.second;
+        out << '\n';
+    }
+    else if (result.exhausted && !result.lifeLossPruned)
+        out << "NOT solvable - every reachable state was searched\n";
+    else if (result.exhausted)
+        out << "no solution without losing a life - every state short of that was searched\n";
+    else
+        out << "no solution within the state limit\n";
+
+    out << result.states << " states in " << result.seconds << " s\n";
+}
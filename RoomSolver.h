@@ -0,0 +1,53 @@
+#pragma once
+#include "Point.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+constexpr size_t DEFAULT_SOLVER_STATES = 2000000;     // distinct states searched before giving up
+
+// Outcome of solving one room
+struct SolverResult {
+    bool solved = false;
+    bool exhausted = false;        // no state was dropped for the state limit (up to the tick bound, if any)
+    bool lifeLossPruned = false;   // states where a player lost a life were skipped
+    bool shortest = false;         // ticks is the par time - no input with fewer cycles gets through
+    size_t ticks = 0;              // cycles of the solution found (an upper bound of par unless shortest)
+    int reachedRoom = -1;          // room the solution ends in
+    int actors = 0;                // bit mask of the players that press keys in the solution
+    std::vector<std::pair<size_t, char>> inputs;    // (cycle, key) of the solution, as in a .steps file
+    size_t states = 0;             // distinct states seen
+    double seconds = 0;
+    std::string error;             // level files couldn't be loaded / bad room
+};
+
+// Breadth-first search over the real simulation for the shortest two-player input that takes a player
+// through one of the room's doors. Every cycle each player either presses nothing or one of its six
+// keys (up to 49 joint actions - keys that wouldn't change anything are skipped). States are the
+// whole game state, so pushed obstacles, toggled switches, carried keys and compressed springs all
+// count. Duplicates are caught by a lock-free transposition table on GameBase::stateHash, and each
+// BFS level is expanded by a pool of worker threads, every one with its own game, restoring
+// copy-on-write snapshots of the frontier.
+// States where a player loses a life are pruned. The joint search grows with both players' positions
+// multiplied together, so each player is first searched alone (the other presses nothing). The shorter
+// of those is only an upper bound: the joint search then looks for anything shorter, and par is proven
+// once it has covered every input up to that bound. Rooms neither player can pass alone get a full
+// joint search. A room is only reported unsolvable when that search pruned nothing.
+class RoomSolver {
+private:
+    int numThreads;
+    size_t maxStates;
+
+public:
+    RoomSolver(int threads, size_t states = DEFAULT_SOLVER_STATES);
+
+    // Players start on the given cells, indexed by PlayerID (moved to the nearest free cell if blocked);
+    // targetRoom -1 accepts any door
+    SolverResult solve(const std::string& levelSet, int roomID, const Point startCells[NUM_PLAYERS],
+                       int targetRoom = -1) const;
+    SolverResult solve(const std::string& levelSet, int roomID, int targetRoom = -1) const;     // from the game's start cells
+
+    static void report(std::ostream& out, int roomID, const SolverResult& result);
+};
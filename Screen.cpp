@@ -1,5 +1,27 @@
 #include "Screen.h"
+#include "StateIO.h"
 #include <iostream>
+#include <algorithm>
+
+// Metadata coordinates are range-checked before they become a Point (one byte per axis)
+static bool checkOnBoard(int x, int y, std::string& errorMsg)
+{
+	if (Point::checkLimits(x, y))
+		return true;
+	errorMsg = "Position (" + std::to_string(x) + "," + std::to_string(y) + ") is outside the board";
+	return false;
+}
+
+// Door IDs and key counts are kept in int8_t fields (Door, Key, Switch) - larger values would wrap
+constexpr int MAX_DOOR_FIELD = INT8_MAX;
+
+static bool checkInRange(const char* field, int value, int maxValue, std::string& errorMsg)
+{
+	if (value >= 0 && value <= maxValue)
+		return true;
+	errorMsg = std::string(field) + " " + std::to_string(value) + " is out of range (0-" + std::to_string(maxValue) + ")";
+	return false;
+}
 
 // Init Functions
 
@@ -9,6 +31,7 @@ void Screen::setMap(const char* map[SCREEN_HEIGHT])
 	for (int r = 0; r < SCREEN_HEIGHT; r++)
 		for (int c = 0; c < SCREEN_WIDTH; c++)
 			board[c][r] = map[r][c];
+	rehash();
 }
 
 /*
@@ -34,6 +57,7 @@ bool Screen::loadScreenFromFile(const std::string& filename, std::string& errorM
 	if (!readDataFromFile(file, filename, errorMsg))
 		return false;
 
+	rehash();
 	return true;
 }
 
@@ -207,7 +231,13 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 	{
 		int x1, x2, y1, y2;
 
-		ss >> x1 >> y1 >> x2 >> y2;
+		if (!(ss >> x1 >> y1 >> x2 >> y2))
+		{
+			errorMsg = "Invalid DARK format (expected: DARK x1 y1 x2 y2)";
+			return false;
+		}
+		if (!checkOnBoard(x1, y1, errorMsg) || !checkOnBoard(x2, y2, errorMsg))
+			return false;
 
 		addDarkArea(Point(x1, y1), Point(x2, y2));
 	}
@@ -221,6 +251,9 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 			errorMsg = "Invalid Door rule format" ;
 			return false;
 		}
+		if (!checkOnBoard(x, y, errorMsg) || !checkInRange("DoorID", doorID, MAX_DOOR_FIELD, errorMsg) ||
+			!checkInRange("KEYS", keys, MAX_DOOR_FIELD, errorMsg) || !checkInRange("RULE", rule, NO_RULE, errorMsg))
+			return false;
 		// Ensure the rule refers to an existing door on the board
 		Door* d = getDoorAt(Point(x, y));
 		if (!d)
@@ -242,6 +275,8 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 			errorMsg = "Invalid Key rule format";
 			return false;
 		}
+		if (!checkOnBoard(x, y, errorMsg) || !checkInRange("DoorID", doorID, MAX_DOOR_FIELD, errorMsg))
+			return false;
 
 		Key* k = getKeyAt(Point(x, y));
 		
@@ -263,6 +298,8 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 			errorMsg = "Invalid Switch rule format";
 			return false;
 		}
+		if (!checkOnBoard(x, y, errorMsg) || !checkInRange("DoorID", doorID, MAX_DOOR_FIELD, errorMsg))
+			return false;
 
 		Switch* sw = getSwitchAt(Point(x, y));
 		
@@ -283,6 +320,8 @@ bool Screen::parseDataLine(const std::string& line, std::string& errorMsg)
 			errorMsg = "Invalid TELEPORT format (expected: TELEPORT x1 y1 x2 y2)";
 			return false;
 		}
+		if (!checkOnBoard(x1, y1, errorMsg) || !checkOnBoard(x2, y2, errorMsg))
+			return false;
 		return addTeleporterPair(Point(x1, y1), Point(x2, y2), errorMsg);
 	}
 
@@ -577,7 +616,21 @@ void Screen::addDarkArea(const Point& topLeft, const Point& bottomRight)
 
 void Screen::addObstacle(const Obstacle& ob)
 {
-	obstacles.emplace_back(ob);
+	addObject(ob);
+	indexObstacle(obstacles.size() - 1, true);
+}
+
+void Screen::indexObstacle(size_t i, bool covers)
+{
+	for (const Point& cell : obstacles[i].getBody())
+		obstacleIndex[cell.getY() * SCREEN_WIDTH + cell.getX()] = covers ? static_cast<uint16_t>(i + 1) : 0;
+}
+
+void Screen::reindexObstacles()
+{
+	std::fill(std::begin(obstacleIndex), std::end(obstacleIndex), 0);
+	for (size_t i = 0; i < obstacles.size(); ++i)
+		indexObstacle(i, true);
 }
 
 void Screen::clearRoom()
@@ -592,7 +645,6 @@ void Screen::clearRoom()
 
 	// clear all objects
 	resetObjects();
-	
 }
 
 void Screen::resetObjects()
@@ -609,68 +661,206 @@ void Screen::resetObjects()
 	riddles.clear();
 	obstacles.clear();
 	teleporters.clear();
+	reindexObstacles();
+	rehash();
 }
 
-// Display Functions
+// Recomputes the state hash from scratch: every board cell plus every object record.
+uint64_t Screen::computeHash() const
+{
+	uint64_t h = 0;
+	for (int y = 0; y < SCREEN_HEIGHT; ++y)
+		for (int x = 0; x < SCREEN_WIDTH; ++x)
+			h ^= Zobrist::cell(Point(x, y), board[x][y]);
+
+	for (const auto& d : doors)      h ^= d.hashKey();
+	for (const auto& k : keys)       h ^= k.hashKey();
+	for (const auto& b : bombs)      h ^= b.hashKey();
+	for (const auto& sp : springs)   h ^= sp.hashKey();
+	for (const auto& sw : switches)  h ^= sw.hashKey();
+	for (const auto& t : torches)    h ^= t.hashKey();
+	for (const auto& r : riddles)    h ^= r.hashKey();
+	for (const auto& ob : obstacles) h ^= ob.hashKey();
+	return h;
+}
+
+// Rewind journal
 
-void Screen::drawChar(const Point& p,const char c)
+// Puts back everything the delta recorded - cells newest first, so each one ends with its oldest value
+void Screen::undo(const RoomDelta& delta)
 {
-	// Draws a character on screen and updates the board buffer.
-    board[p.getX()][p.getY()] = c;
-	if (isVisible(p))
+	for (auto it = delta.cells.rbegin(); it != delta.cells.rend(); ++it)
+		setCell(Point(it->first / SCREEN_HEIGHT, it->first % SCREEN_HEIGHT), it->second);
+
+	if (delta.hasObjects)
 	{
-		Utils::gotoxy(p);
-		std::cout << c;
+		std::apply([this](const auto&... undos) { (undoObjects(undos), ...); }, delta.objects);
+		reindexObstacles();
+		rehash();
 	}
 }
 
-void Screen::erase(const Point& p)
+// Object changes of one list, newest first
+template <typename T>
+void Screen::undoObjects(const std::vector<ObjectUndo<T>>& undos)
 {
-	if (Point::checkLimits(p)) {
-		board[p.getX()][p.getY()] = ' ';
+	std::vector<T>& list = listOf(static_cast<const T*>(nullptr));
+	for (auto it = undos.rbegin(); it != undos.rend(); ++it)
+	{
+		switch (it->change)
+		{
+		case ObjectChange::CHANGED:
+			list[it->index] = it->old;
+			break;
+		case ObjectChange::ADDED:
+			list.pop_back();
+			break;
+		case ObjectChange::SWAP_REMOVED:    // the last object had been moved into the gap
+			if (it->index < list.size())
+			{
+				list.push_back(list[it->index]);
+				list[it->index] = it->old;
+			}
+			else
+				list.push_back(it->old);
+			break;
+		case ObjectChange::ERASED:
+			list.insert(list.begin() + it->index, it->old);
+			break;
+		}
 	}
 }
 
-// Draws the full screen: map base + all active items.
-void Screen::drawScreen() 
+template <typename T>
+static size_t undoBytes(const std::vector<ObjectUndo<T>>& undos)
 {
-	drawBase();
-	drawItems();
+	size_t bytes = undos.capacity() * sizeof(ObjectUndo<T>);
+	for (const ObjectUndo<T>& undo : undos)
+		bytes += heapBytes(undo.old);
+	return bytes;
 }
 
-// Prints the entire board buffer to the console.
-void Screen::drawBase()                       
+size_t RoomDelta::byteSize() const
 {
-	for (int y = 0; y < SCREEN_HEIGHT; ++y)
+	size_t bytes = cells.capacity() * sizeof(cells[0]);
+	std::apply([&bytes](const auto&... undos) { ((bytes += undoBytes(undos)), ...); }, objects);
+	return bytes;
+}
+
+// Writes the room's mutable state. The board is run-length encoded - rooms are mostly blank.
+void Screen::saveState(std::ostream& out) const
+{
+	const char* cells = &board[0][0];
+	for (int i = 0; i < BOARD_CELLS; )
 	{
-		Utils::gotoxy(0, y);
+		uint8_t run = 1;
+		while (i + run < BOARD_CELLS && run < UINT8_MAX && cells[i + run] == cells[i])
+			run++;
+		StateIO::write(out, run);
+		StateIO::write(out, cells[i]);
+		i += run;
+	}
 
-		for (int x = 0; x < SCREEN_WIDTH; ++x)
-		{
-			Point p(x, y);
+	StateIO::writeVector(out, doors);
+	StateIO::writeVector(out, keys);
+	StateIO::writeVector(out, bombs);
+	StateIO::writeVector(out, springs);
+	StateIO::writeVector(out, switches);
+	StateIO::writeVector(out, torches);
+	StateIO::writeVector(out, teleporters);
 
-			if (isVisible(p) || board[x][y] == BOARD_WALL)
-				std::cout << board[x][y];
-			else
-				std::cout << DARK_CHAR;   
-		}
+	StateIO::write(out, static_cast<uint32_t>(riddles.size()));
+	for (const Riddle& r : riddles)
+		r.saveState(out);
+
+	StateIO::write(out, static_cast<uint32_t>(obstacles.size()));
+	for (const Obstacle& ob : obstacles)
+		ob.saveState(out);
+}
+
+bool Screen::loadState(std::istream& in)
+{
+	++revision;         // changed even if the state turns out to be bad
+	char* cells = &board[0][0];
+	for (int i = 0; i < BOARD_CELLS; )
+	{
+		uint8_t run = 0;
+		char c = ' ';
+		if (!StateIO::read(in, run) || !StateIO::read(in, c) || run == 0 || i + run > BOARD_CELLS)
+			return false;
+		std::fill(cells + i, cells + i + run, c);
+		i += run;
 	}
+
+	if (!StateIO::readVector(in, doors) || !StateIO::readVector(in, keys) ||
+		!StateIO::readVector(in, bombs) || !StateIO::readVector(in, springs) ||
+		!StateIO::readVector(in, switches) || !StateIO::readVector(in, torches) ||
+		!StateIO::readVector(in, teleporters))
+		return false;
+
+	uint32_t count = 0;
+	if (!StateIO::read(in, count)) return false;
+	riddles.assign(count, Riddle());
+	for (Riddle& r : riddles)
+		if (!r.loadState(in)) return false;
+
+	if (!StateIO::read(in, count)) return false;
+	obstacles.assign(count, Obstacle());
+	bool bodiesRead = true;
+	for (Obstacle& ob : obstacles)
+		if (!(bodiesRead = ob.loadState(in))) break;
+	reindexObstacles();
+	if (!bodiesRead) return false;
+
+	illuminated.reset();
+	rehash();
+	return true;
 }
 
-// Draws all visible objects onto the screen.
-void Screen::drawItems()
+// Display Functions
+
+void Screen::setCell(const Point& p, char c)
+{
+	char& cell = board[p.getX()][p.getY()];
+	if (cell == c) return;
+	++revision;
+
+	if (journal)
+		journal->cells.emplace_back(static_cast<uint16_t>(p.getX() * SCREEN_HEIGHT + p.getY()), cell);
+
+	stateHash ^= Zobrist::cell(p, cell) ^ Zobrist::cell(p, c);
+	cell = c;
+}
+
+void Screen::place(const Point& p, const char c)
+{
+	if (Point::checkLimits(p)) {
+		setCell(p, c);
+	}
+}
+
+void Screen::erase(const Point& p)
+{
+	if (Point::checkLimits(p)) {
+		setCell(p, ' ');
+	}
+}
+
+// Writes all active objects into the board buffer. Called by the game logic once per tick,
+// so the board is the same whether or not the room is ever printed.
+void Screen::syncItems()
 {
 
 	for (const auto& d : doors) {
 		Point p = d.getPos();
 		char fig = d.getFigure();
-		drawChar(p, fig);
+		setCell(p, fig);
 	}
 
 	for (const auto& sw : switches) {
 		Point p = sw.getPos();
 		char fig = sw.getFigure();
-		drawChar(p, fig);
+		setCell(p, fig);
 	}
 
 	for (const auto& k : keys) {
@@ -678,7 +868,7 @@ void Screen::drawItems()
 		{
 			Point p = k.getPos();
 			char fig = k.getFigure();
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
@@ -687,7 +877,7 @@ void Screen::drawItems()
 		{
 			Point p = b.getPos();
 			char fig = b.getFigure();
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
@@ -696,7 +886,7 @@ void Screen::drawItems()
 		{
 			Point p = r.getPos();
 			char fig = r.getFigure();
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
@@ -705,7 +895,7 @@ void Screen::drawItems()
 		{
 			Point p = t.getPos();
 			char fig = t.getFigure();
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
@@ -715,18 +905,18 @@ void Screen::drawItems()
 		{
 			Point p = sp.getLinkPos(k);
 			char fig = sp.getFigure();
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
 	for (const Obstacle& ob : obstacles)
 	{
-		const std::vector<Point>& body = ob.getBody();
+		const ObstacleBody& body = ob.getBody();
 		char fig = ob.getFigure();
 
 		for (const Point& p : body)
 		{
-			drawChar(p, fig);
+			setCell(p, fig);
 		}
 	}
 
@@ -788,6 +978,30 @@ bool Screen::isSpring(const Point& p) const
 	return charAt(p) == BOARD_SPRING;
 }
 
+// Swept query along a movement path: returns the index of the first cell (from 'from' on)
+// that needs interaction handling - anything that is not a plain empty cell, a cell entered
+// from a teleporter, or a step taken with a spring in front of the player (the spring handler
+// looks one cell ahead in the facing direction, which can be off the path when moving sideways).
+// Returns length if the whole rest of the path is plain.
+int Screen::sweep(const Point& start, const Point* path, int from, int length, Direction facing) const
+{
+	for (int i = from; i < length; i++)
+	{
+		const Point& prev = (i == 0) ? start : path[i - 1];
+		if (charAt(prev) == BOARD_TELEPORT)
+			return i;
+
+		const Point ahead = prev.next(facing);
+		if (Point::checkLimits(ahead) && isSpring(ahead))
+			return i;
+
+		const Point& p = path[i];
+		if (!Point::checkLimits(p) || isLegendCell(p) || charAt(p) != ' ')
+			return i;
+	}
+	return length;
+}
+
 /// Get Objects Functions
 
 Spring* Screen::getSpringAt(Point p)
@@ -805,12 +1019,8 @@ Spring* Screen::getSpringAt(Point p)
 
 Obstacle* Screen::getObstacleAt(Point p)
 {
-	for (Obstacle& ob : obstacles)
-	{
-		if (ob.isObBody(p))
-			return &ob;
-	}
-	return nullptr;   // no obstacle at this position
+	const uint16_t i = obstacleIndex[p.getY() * SCREEN_WIDTH + p.getX()];
+	return i ? &obstacles[i - 1] : nullptr;   // 0 - no obstacle at this position
 }
 
 ItemType Screen::getItemType(const Point& p) const    
@@ -821,6 +1031,8 @@ ItemType Screen::getItemType(const Point& p) const
 	if (c == BOARD_BOMB) return BOMB;
 	
 	if (c == BOARD_TORCH) return TORCH;
+
+	return NONE;
 }
 
 Door& Screen::getDoorById(int id)
@@ -854,8 +1066,8 @@ void Screen::collectKey(Player& player, const Point& p)
 	for (int i = 0; i < keys.size(); i++) {
 		if (keys[i].isActive() && keys[i].getPos()==p) {
 
-			player.collectItem(KEY, i);
-			keys[i].deactivate();
+			player.collectItem(KEY, keys[i].getId());
+			modify(keys[i], [](Key& k) { k.deactivate(); });
 			erase(p);
 			break;
 		}
@@ -867,8 +1079,8 @@ void Screen::collectBomb(Player& player, const Point& p)
 	for (int i = 0; i < bombs.size(); i++) {
 		if (bombs[i].isActive() && !bombs[i].isTicking() && bombs[i].getPos()==p) {
 
-			player.collectItem(BOMB, i);
-			bombs[i].deactivate();
+			player.collectItem(BOMB, bombs[i].getId());
+			modify(bombs[i], [](Bomb& b) { b.deactivate(); });
 			erase(p);
 			break;
 		}
@@ -881,23 +1093,48 @@ void Screen::collectTorch(Player& player, const Point& p)
 	{
 		if (torches[i].isActive() && torches[i].getPos()==p)
 		{
-			player.collectItem(TORCH, i);
-			torches[i].deactivate();
+			player.collectItem(TORCH, torches[i].getId());
+			modify(torches[i], [](Torch& t) { t.deactivate(); });
 			erase(p);
 			break;
 		}
 	}
 }
 
-void Screen::pushObstacle(Obstacle& ob, Direction dir)
-{    // Clears obstacle from board and moves it atomically
+void Screen::pushObstacles(const std::vector<Obstacle*>& chain, Direction dir)
+{    // Moves touching obstacles one cell as one body: every body leaves the board before any is written
+	 // back, so one obstacle's old cells can't erase another's new ones
 
-	for (const Point& cell : ob.getBody())   	// Remove all current obstacle cells from the board
+	for (const Obstacle* ob : chain)   	// Remove all current obstacle cells from the board
 	{
-		erase(cell);
+		indexObstacle(ob - obstacles.data(), false);
+		for (const Point& cell : ob->getBody())
+			erase(cell);
 	}
-	// Move the entire obstacle body
-	ob.move(dir);
+
+	for (Obstacle* ob : chain)
+		modify(*ob, [dir](Obstacle& o) { o.move(dir); });
+
+	for (const Obstacle* ob : chain)   	// Write the bodies back at their new cells
+	{
+		indexObstacle(ob - obstacles.data(), true);
+		for (const Point& cell : ob->getBody())
+			setCell(cell, ob->getFigure());
+	}
+}
+
+bool Screen::obstacleCellsIntact() const
+{
+	size_t bodyCells = 0;
+	for (size_t i = 0; i < obstacles.size(); ++i)
+		for (const Point& cell : obstacles[i].getBody())
+		{
+			if (charAt(cell) != BOARD_OBSTACLE || obstacleIndex[cell.getY() * SCREEN_WIDTH + cell.getX()] != i + 1)
+				return false;
+			bodyCells++;
+		}
+	return bodyCells == static_cast<size_t>(std::count_if(std::begin(obstacleIndex), std::end(obstacleIndex),
+		[](uint16_t i) { return i != 0; }));
 }
 
 // Legend helpers
@@ -936,6 +1173,7 @@ void Screen::clearLegendAreaFromBoard()
 			board[x][y] = ' ';
 		}
 	}
+	rehash();
 }
 
 // Dark Areas & Torch helpers
@@ -970,12 +1208,6 @@ bool Screen::isInDarkArea(const Point& p) const
 	return false;
 }
 
-bool Screen::isIlluminated(const Point& p) const  // MAYBE MOVE TO HEADER AS INLINE
-{
-	// Returns whether the given cell is currently marked as illuminated
-	return illuminated[p.getX()][p.getY()];
-}
-
 void Screen::illuminateMap(const Point& center)
 {   // Illuminates a circular area around a given center point.
 	int cx = center.getX();
@@ -997,7 +1229,7 @@ void Screen::illuminateMap(const Point& center)
 				continue;
 
 			// Always illuminate the center cell
-			illuminated[x][y] = true;
+			illuminated[y * SCREEN_WIDTH + x] = true;
 		}
 	}
 }
@@ -1005,13 +1237,7 @@ void Screen::illuminateMap(const Point& center)
 void Screen::clearIllumination()
 {
 	// Clears all illumination marks before recalculating lighting.
-	for (int y = 0; y < SCREEN_HEIGHT; y++)
-	{
-		for (int x = 0; x < SCREEN_WIDTH; x++)
-		{
-			illuminated[x][y] = false;
-		}
-	}
+	illuminated.reset();
 }
 
 
@@ -1023,11 +1249,11 @@ bool Screen::removeObjectsAt(const Point& p)
 {
 	bool removed = false;
 
-	removed |= removeItemAt(doors, p);
-	removed |= removeItemAt(keys, p);
-	removed |= removeItemAt(switches, p);
-	removed |= removeItemAt(riddles, p);
-	removed |= removeItemAt(torches, p);
+	removed |= removeObjectAt(doors, p);
+	removed |= removeObjectAt(keys, p);
+	removed |= removeObjectAt(switches, p);
+	removed |= removeObjectAt(riddles, p);
+	removed |= removeObjectAt(torches, p);
 	removed |= removeTeleporterAt(p);
 
 	removeSpringAt(p);
@@ -1048,7 +1274,8 @@ bool Screen::removeSpringAt(const Point& p) {
 				for (int i = 0; i < it->getCurrSize(); i++) { //fully delete spring so we won't have "flying" links
 					erase(it->getLinkPos(i)); //erase from screen
 				}
-				springs.erase(it); //erase from vector
+				stateHash ^= it->hashKey();
+				eraseObject(springs, it - springs.begin()); //erase from vector
 				return true;
 			}
 
@@ -1059,7 +1286,7 @@ bool Screen::removeSpringAt(const Point& p) {
 				}
 
 				int linksToRemove = it->getCurrSize() - hitIndex; //logic: how many links were removed
-				it->decreaseSize(linksToRemove);
+				modify(*it, [linksToRemove](Spring& sp) { sp.decreaseSize(linksToRemove); });
 			}
 			return true;
 		}
@@ -1078,11 +1305,13 @@ void Screen::removeObstacleAt(const Point& p)
 		{
 			if (body[j] == p)
 			{
-				body.erase(body.begin() + j);
+				modify(ob, [j](Obstacle& o) { o.getBody().erase(o.getBody().begin() + j); });
+				obstacleIndex[p.getY() * SCREEN_WIDTH + p.getX()] = 0;
 
 				if (body.empty())
 				{
-					obstacles.erase(obstacles.begin() + i);
+					eraseObject(obstacles, i);
+					reindexObstacles();     // the obstacles after i moved down one place
 				}
 				return;
 			}
@@ -1098,14 +1327,56 @@ bool Screen::removeTeleporterAt(const Point& p)
 		// if point is p or p dest
 		if (teleporters[i].p1 == p || teleporters[i].p2 == p)
 		{
-			// screen
-			drawChar(teleporters[i].p1, ' ');
-			drawChar(teleporters[i].p2, ' ');
+			// board
+			erase(teleporters[i].p1);
+			erase(teleporters[i].p2);
 			// logic
-			teleporters.erase(teleporters.begin() + i);
+			eraseObject(teleporters, i);
 			removed = true;
 		}
 	}
 	return removed;
 }
 
+// One "<name> <value>" line per object (its fields as field=value) and per board row
+void Screen::dumpState(std::ostream& out, const std::string& prefix) const {
+	auto at = [](const Point& p) { return "(" + std::to_string(p.getX()) + "," + std::to_string(p.getY()) + ")"; };
+
+	for (size_t i = 0; i < doors.size(); ++i) {
+		const Door& d = doors[i];
+		out << prefix << "door" << i << " pos=" << at(d.getPos()) << " dest=" << d.getDestination()
+			<< " keys=" << d.getNeededKeys() << " open=" << d.checkIsOpen()
+			<< " keyOK=" << d.getKeyStatus() << " switchOK=" << d.getSwitchStatus() << '\n';
+	}
+	for (size_t i = 0; i < keys.size(); ++i)
+		out << prefix << "key" << i << " pos=" << at(keys[i].getPos()) << " active=" << keys[i].isActive()
+			<< " id=" << keys[i].getId() << " door=" << keys[i].getDoorID() << '\n';
+	for (size_t i = 0; i < bombs.size(); ++i)
+		out << prefix << "bomb" << i << " pos=" << at(bombs[i].getPos()) << " active=" << bombs[i].isActive()
+			<< " id=" << bombs[i].getId() << " ticking=" << bombs[i].isTicking() << " timer=" << bombs[i].getTimer() << '\n';
+	for (size_t i = 0; i < springs.size(); ++i)
+		out << prefix << "spring" << i << " pos=" << at(springs[i].getPos()) << " size=" << springs[i].getCurrSize()
+			<< "/" << springs[i].getFullSize() << " dir=" << static_cast<int>(springs[i].getDir()) << '\n';
+	for (size_t i = 0; i < switches.size(); ++i)
+		out << prefix << "switch" << i << " pos=" << at(switches[i].getPos()) << " on=" << switches[i].getState() << '\n';
+	for (size_t i = 0; i < torches.size(); ++i)
+		out << prefix << "torch" << i << " pos=" << at(torches[i].getPos()) << " active=" << torches[i].isActive()
+			<< " id=" << torches[i].getId() << '\n';
+	for (size_t i = 0; i < riddles.size(); ++i)
+		out << prefix << "riddle" << i << " pos=" << at(riddles[i].getPos()) << " solved=" << riddles[i].isSolved() << '\n';
+	for (size_t i = 0; i < obstacles.size(); ++i) {
+		out << prefix << "obstacle" << i << " cells=";
+		for (const Point& p : obstacles[i].getBody())
+			out << at(p);
+		out << '\n';
+	}
+	for (size_t i = 0; i < teleporters.size(); ++i)
+		out << prefix << "teleport" << i << " pos=" << at(teleporters[i].p1) << " to=" << at(teleporters[i].p2) << '\n';
+
+	for (int y = 0; y < SCREEN_HEIGHT; ++y) {
+		out << prefix << "row" << (y < 10 ? "0" : "") << y << ' ';
+		for (int x = 0; x < SCREEN_WIDTH; ++x)
+			out << board[x][y];
+		out << '\n';
+	}
+}
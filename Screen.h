@@ -12,11 +12,15 @@
 #include "Riddle.h"
 #include "Maps.h"
 #include "Templates.h"
+#include "Zobrist.h"
 #include <fstream>
 #include <string>
 #include <vector>
 #include <set>
+#include <tuple>
+#include <bitset>
 #include <stdexcept>
+#include <cstring>
 
 struct LegendArea{
 	Point topLeft;
@@ -34,6 +38,39 @@ struct TeleportPair {
 	Point p2;
 };
 
+// Heap memory a record owns beyond its own size (counted against the rewind memory cap)
+template <typename T>
+size_t heapBytes(const T&) { return 0; }
+inline size_t heapBytes(const Riddle& r) { return r.heapBytes(); }
+inline size_t heapBytes(const Obstacle& ob) { return ob.heapBytes(); }
+
+// One change to an object list, with what is needed to take it back
+enum class ObjectChange : uint8_t { CHANGED, ADDED, SWAP_REMOVED, ERASED };
+
+template <typename T>
+struct ObjectUndo {
+	ObjectChange change;
+	uint16_t index;     // position of the object in its list
+	T old;              // the object before the change (unused for ADDED)
+};
+
+// Everything needed to undo one tick of changes to a room (rewind): the old value of every
+// board cell written, in write order, and every change to an object list, in change order.
+struct RoomDelta {
+	std::vector<std::pair<uint16_t, char>> cells;   // board index, previous char
+	bool hasObjects = false;
+
+	std::tuple<std::vector<ObjectUndo<Door>>, std::vector<ObjectUndo<Key>>, std::vector<ObjectUndo<Bomb>>,
+		std::vector<ObjectUndo<Spring>>, std::vector<ObjectUndo<Switch>>, std::vector<ObjectUndo<Torch>>,
+		std::vector<ObjectUndo<Riddle>>, std::vector<ObjectUndo<Obstacle>>, std::vector<ObjectUndo<TeleportPair>>> objects;
+
+	template <typename T>
+	std::vector<ObjectUndo<T>>& undos() { return std::get<std::vector<ObjectUndo<T>>>(objects); }
+
+	bool empty() const { return cells.empty() && !hasObjects; }
+	size_t byteSize() const;    // heap memory held by this delta (vector capacity and the records' own heap memory)
+};
+
 class Screen {
 private:
 	char board[SCREEN_WIDTH][SCREEN_HEIGHT]; // 2D buffer storing the room's characters 
@@ -41,8 +78,7 @@ private:
 	std::vector<DarkArea> darkAreas;       // Stores all predefined dark regions in the room.
 	LegendArea legend;
 
-	bool illuminated[SCREEN_WIDTH][SCREEN_HEIGHT];      // Marks which cells are currently illuminated by torches.
-	bool validationMask[SCREEN_HEIGHT][SCREEN_WIDTH];  	// Used for object placement validation during screen loading
+	std::bitset<SCREEN_WIDTH * SCREEN_HEIGHT> illuminated;   // Marks which cells are currently illuminated by torches (one bit per cell).
 	std::string sourceFile;
 
 	std::vector<Door> doors;
@@ -54,9 +90,70 @@ private:
 	std::vector<Riddle> riddles;
 	std::vector<Obstacle> obstacles;
 	std::vector<TeleportPair> teleporters;
+	uint16_t obstacleIndex[SCREEN_WIDTH * SCREEN_HEIGHT];   // [y * SCREEN_WIDTH + x] - 1 + index of the obstacle covering the cell, 0 for none
+
+	uint64_t stateHash = 0;     // Zobrist hash of the board cells and all objects, kept up to date by every mutation
+	uint64_t revision = 0;      // bumped by every change - tells whether a room still matches a copy of it
+	RoomDelta* journal = nullptr;   // when set, every change of this tick is recorded here (not owned)
+
+	void setCell(const Point& p, char c);   // the only way cells change during play - keeps stateHash in sync
+	void indexObstacle(size_t i, bool covers);   // marks (or clears) the cells of obstacles[i] in obstacleIndex
+	void reindexObstacles();                     // rebuilds obstacleIndex - after the obstacle list is reordered or replaced
+
+	// The list each object type lives in
+	std::vector<Door>& listOf(const Door*) { return doors; }
+	std::vector<Key>& listOf(const Key*) { return keys; }
+	std::vector<Bomb>& listOf(const Bomb*) { return bombs; }
+	std::vector<Spring>& listOf(const Spring*) { return springs; }
+	std::vector<Switch>& listOf(const Switch*) { return switches; }
+	std::vector<Torch>& listOf(const Torch*) { return torches; }
+	std::vector<Riddle>& listOf(const Riddle*) { return riddles; }
+	std::vector<Obstacle>& listOf(const Obstacle*) { return obstacles; }
+	std::vector<TeleportPair>& listOf(const TeleportPair*) { return teleporters; }
+
+	// Collected items stay in their list while a player holds them - they are not on the board
+	static bool isHeld(const Key& k) { return !k.isActive(); }
+	static bool isHeld(const Bomb& b) { return !b.isActive(); }
+	static bool isHeld(const Torch& t) { return !t.isActive(); }
+	template <typename T>
+	static bool isHeld(const T&) { return false; }
+
+	template <typename T>
+	void journalObject(ObjectChange change, size_t index, const T& old) {   // records one object change for undo
+		++revision;
+		if (!journal) return;
+		journal->undos<T>().push_back({ change, static_cast<uint16_t>(index), old });
+		journal->hasObjects = true;
+	}
+	template <typename T>
+	void addObject(const T& obj) {
+		std::vector<T>& list = listOf(&obj);
+		journalObject(ObjectChange::ADDED, list.size(), T());
+		list.push_back(obj);
+		stateHash ^= obj.hashKey();
+	}
+	template <typename T>
+	bool removeObjectAt(std::vector<T>& list, const Point& p) {   // swap & pop of the first object at p
+		for (size_t i = 0; i < list.size(); ++i) {
+			if (list[i].getPos() != p || isHeld(list[i])) continue;
+			journalObject(ObjectChange::SWAP_REMOVED, i, list[i]);
+			stateHash ^= list[i].hashKey();
+			list[i] = std::move(list.back());
+			list.pop_back();
+			return true;
+		}
+		return false;
+	}
+	template <typename T>
+	void eraseObject(std::vector<T>& list, size_t index) {        // keeps the order of the rest (hash left to the caller)
+		journalObject(ObjectChange::ERASED, index, list[index]);
+		list.erase(list.begin() + index);
+	}
+	template <typename T>
+	void undoObjects(const std::vector<ObjectUndo<T>>& undos);
 
 public:
-	Screen() = default;                 // default ctor 
+	Screen() { clearRoom(); }           // default ctor - blank board, so unused rooms hash the same every run
 
 	void setMap(const char* map[SCREEN_HEIGHT]);
 	bool loadScreenFromFile(const std::string& filename, std::string& errorMsg, std::string& warningMsg);
@@ -81,37 +178,67 @@ public:
 	void resetObjects();
 
 	void addDarkArea(const Point& topLeft, const Point& bottomRight);
-	void addDoor(const Door& d) { doors.push_back(d); }
-	void addKey(const Key& k) { keys.push_back(k); }
-	void addBomb(const Bomb& b) { bombs.push_back(b); }
-	void addSpring(const Spring& s) { springs.push_back(s); }
-	void addSwitch(const Switch& sw) { switches.push_back(sw); }
-	void addTorch(const Torch& t) { torches.push_back(t); }
-	void addRiddle(const Riddle& r) { riddles.push_back(r); }
+	void addDoor(const Door& d) { addObject(d); }
+	void addKey(Key k) { k.setId(nextItemId(keys)); addObject(k); }
+	void addBomb(Bomb b) { b.setId(nextItemId(bombs)); addObject(b); }
+	void addSpring(const Spring& s) { addObject(s); }
+	void addSwitch(const Switch& sw) { addObject(sw); }
+	void addTorch(Torch t) { t.setId(nextItemId(torches)); addObject(t); }
+	void addRiddle(const Riddle& r) { addObject(r); }
 	void addObstacle(const Obstacle& ob);
 
-	// Display Functions
-	void drawChar(const Point& p, char c); // draws specific char at point in screen
+	// State hash
+	uint64_t getStateHash() const { return stateHash; }
+	uint64_t computeHash() const;   // hash recomputed from scratch (stateHash must always equal it)
+	void rehash() { stateHash = computeHash(); ++revision; }   // only needed after loading / bulk board writes
+	uint64_t getRevision() const { return revision; }
+
+	// Rewind journal
+	void setJournal(RoomDelta* delta) { journal = delta; }
+	void undo(const RoomDelta& delta);
+
+	// Binary state (board + objects). Dark areas, legend and source file come from the room file.
+	void saveState(std::ostream& out) const;
+	bool loadState(std::istream& in);
+	void dumpState(std::ostream& out, const std::string& prefix) const;   // text form, for replay bisection
+
+	template <typename T, typename F>
+	void modify(T& obj, F change) {    // Applies a change to one of this room's objects and keeps the hash in sync
+		journalObject(ObjectChange::CHANGED, &obj - listOf(&obj).data(), obj);
+		stateHash ^= obj.hashKey();
+		change(obj);
+		stateHash ^= obj.hashKey();
+	}
+
+	// Board Functions (logic only - nothing is printed)
+	void place(const Point& p, char c);   // writes a char into the board at p
 	void erase(const Point& p);    // erases specific char from point in screen
+	void syncItems();              // writes every active object into the board
 	bool isCellFree(const Point& pos) const;
+
+	// Display Functions (Console.cpp)
 	void drawScreen();
 	void drawBase();
-	void drawItems();
 	char charAt(const Point& p) const {   // returns the character stored at the given screen position.
 		return board[p.getX()][p.getY()];
 	}
+	void copyBoard(char (&out)[SCREEN_WIDTH][SCREEN_HEIGHT]) const {   // same [x][y] layout as board
+		std::memcpy(out, board, sizeof(board));
+	}
 	bool isWall(const Point& p) const;
 	bool isItem(const Point& p) const;
 	bool isDoor(const Point& p) const;
 	bool isSwitch(const Point& p) const;
 	bool isObstacle(const Point& p) const;
 	bool isSpring(const Point& p) const;
+	int sweep(const Point& start, const Point* path, int from, int length, Direction facing) const;
 
 	// Get Functions
 
 	std::vector<Bomb>& getBombs() { return bombs; }
 	const std::vector<Bomb>& getBomb() const { return bombs; }
 
+	const std::vector<Door>& getDoors() const { return doors; }
 	const std::vector<Switch>& getSwitches() const { return switches; }
 	const std::vector<Spring>& getSprings() const { return springs; }
 
@@ -133,12 +260,16 @@ public:
 	void collectBomb(Player& player, const Point& p);
 	void collectTorch(Player& player, const Point& p);
 
-	// helps get the key\bomb\torch object from player's inventory
-	Key& getStoredKey(int index) { return keys[index]; }
-	Bomb& getStoredBomb(int index) { return bombs[index]; }
-	Torch& getStoredTorch(int index) { return torches[index]; }
+	// helps get the key\bomb\torch object from player's inventory.
+	// nullptr if the index no longer refers to a held (inactive) item - e.g. the list was
+	// reordered by a swap & pop removal, or the player carried the item into another room
+	Key* getStoredKey(int id) { return getStoredItem(keys, id); }
+	Bomb* getStoredBomb(int id) { return getStoredItem(bombs, id); }
+	Torch* getStoredTorch(int id) { return getStoredItem(torches, id); }
+	const Key* getStoredKey(int id) const { return getStoredItem(keys, id); }
 
-	void pushObstacle(Obstacle& ob, Direction dir);
+	void pushObstacles(const std::vector<Obstacle*>& chain, Direction dir);
+	bool obstacleCellsIntact() const;   // every obstacle body cell reads BOARD_OBSTACLE on the board and is indexed, and nothing else is
 
 	// Legend helpers
 	void setLegendAnchor(int x, int y);
@@ -149,8 +280,9 @@ public:
 	// Dark & Torch helpers
 
 	bool isVisible(const Point& p) const;
+	const std::vector<DarkArea>& getDarkAreas() const { return darkAreas; }
 	bool isInDarkArea(const Point& p) const;
-	bool isIlluminated(const Point& p) const;
+	bool isIlluminated(const Point& p) const { return illuminated[p.getY() * SCREEN_WIDTH + p.getX()]; }   // marked lit by a torch
 	void illuminateMap(const Point& center);
 	void clearIllumination();
 
@@ -159,8 +291,8 @@ public:
 	bool removeSpringAt(const Point& p);
 	void removeObstacleAt(const Point& p);
 	bool removeTeleporterAt(const Point& p);
-	void removeRiddleAt(const Point& p) { removeItemAt(riddles, p); }
-	bool removeBombAt(const Point& p) { return removeItemAt(bombs, p); }
+	void removeRiddleAt(const Point& p) { removeObjectAt(riddles, p); }
+	bool removeBombAt(const Point& p) { return removeObjectAt(bombs, p); }
 
 
 };
@@ -1,25 +1,28 @@
 #pragma once
 #include "Point.h"
 #include "Player.h"
+#include "Zobrist.h"
 
 class Spring {
 private:
     Point basePos;      // Base position of the spring (first cell)
-    char figure = '#';
-    int fullSize;       // Maximum number of links the spring can extend
-    int currSize;       // How many links are currently extended
+    int8_t fullSize;    // Maximum number of links the spring can extend
+    int8_t currSize;    // How many links are currently extended
     Direction dir;      // Direction in which the spring extends
 
 public:
     Spring() : basePos({ 0, 0 }), fullSize(0), currSize(0), dir(UP) {} // default ctor
     Spring (const Point& p, int s, const Direction& d)     // custom ctor
-        : basePos(p), fullSize(s), currSize(s), dir(d) {}
+        : basePos(p), fullSize(static_cast<int8_t>(s)), currSize(static_cast<int8_t>(s)), dir(d) {}
 
     int getCurrSize() const { return currSize; }
     int getFullSize() const { return fullSize; }
-    Point getPos() { return basePos; }
+    Point getPos() const { return basePos; }
     Direction getDir() const { return dir; }
-    char getFigure() const { return figure; }
+    char getFigure() const { return BOARD_SPRING; }
+    uint64_t hashKey() const {   // Zobrist key of this record
+        return Zobrist::key(Zobrist::SPRING, Zobrist::pack(basePos), static_cast<uint8_t>(currSize) | (fullSize << 8) | (dir << 16));
+    }
     Point getTipPos() const;
     Point getLinkPos (int index) const;
 
@@ -27,8 +30,7 @@ public:
     bool isOppositeDir(Direction playerDir) const;
 
     void decreaseSize(int amount = 1) { // Removes one link when compressed / more when exploded
-        currSize -= amount;
-        if (currSize < 0) currSize = 0;
+        currSize = static_cast<int8_t>(currSize > amount ? currSize - amount : 0);
     }    
     int springRelease();
 
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary helpers for saving and restoring game state (replay keyframes).
+// Plain records without padding are written as raw bytes, so equal states always give equal bytes;
+// anything owning memory or with padding between its fields is written field by field.
+namespace StateIO {
+
+    template <typename T>
+    void write(std::ostream& out, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain records can be written raw");
+        static_assert(std::has_unique_object_representations<T>::value, "raw records must have no padding bits");
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::istream& in, T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain records can be read raw");
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    template <typename T>
+    void writeVector(std::ostream& out, const std::vector<T>& items) {
+        write(out, static_cast<uint32_t>(items.size()));
+        for (const T& item : items)
+            write(out, item);
+    }
+
+    template <typename T>
+    bool readVector(std::istream& in, std::vector<T>& items) {
+        uint32_t count = 0;
+        if (!read(in, count)) return false;
+        items.resize(count);
+        for (T& item : items) {
+            if (!read(in, item)) return false;
+        }
+        return true;
+    }
+
+    inline void writeString(std::ostream& out, const std::string& s) {
+        write(out, static_cast<uint32_t>(s.size()));
+        out.write(s.data(), s.size());
+    }
+
+    inline bool readString(std::istream& in, std::string& s) {
+        uint32_t length = 0;
+        if (!read(in, length)) return false;
+        s.resize(length);
+        return length == 0 || static_cast<bool>(in.read(&s[0], length));
+    }
+}
@@ -13,6 +13,21 @@ Steps Steps::loadSteps(const std::string& filename) {
         steps_file >> iteration >> step;
         steps.addStep(iteration, step);
     }
+
+    // Optional trailing sections: "hashes <count>", then one "<cycle> <hash>" line each,
+    // and "end <cycle>" - the session went on after its last key (idle cycles count too)
+    std::string section;
+    while (steps_file >> section) {
+        size_t count = 0;
+        if (section == "hashes" && steps_file >> count) {
+            size_t iteration;
+            uint64_t hash;
+            while (count-- != 0 && steps_file >> iteration >> hash)
+                steps.addStateHash(iteration, hash);
+        }
+        else if (section != "end" || !(steps_file >> steps.endCycle))
+            break;
+    }
     steps_file.close();
     return steps;
 }
@@ -23,5 +38,12 @@ void Steps::saveSteps(const std::string& filename) const {
     for (const auto& step : steps) {
         steps_file << '\n' << step.first << ' ' << step.second;
     }
+    if (!stateHashes.empty()) {
+        steps_file << "\nhashes " << stateHashes.size();
+        for (const auto& entry : stateHashes)
+            steps_file << '\n' << entry.first << ' ' << entry.second;
+    }
+    if (endCycle > 0)
+        steps_file << "\nend " << endCycle;
     steps_file.close();
 }
@@ -1,9 +1,16 @@
 #pragma once
+#include <cstdint>
 #include <iosfwd>
 #include <list>
+#include <string>
+#include <utility>
+#include <vector>
 
 class Steps {
     std::list<std::pair<size_t, char>> steps; // pair: iteration, step
+    uint64_t randomSeed = 0;                  // stored in the file header - the game's Random seed
+    std::vector<std::pair<size_t, uint64_t>> stateHashes;   // cycle, GameBase::stateHash after it (optional section)
+    size_t endCycle = 0;                      // last cycle the session played (optional section, 0 - not recorded)
 public:
     static Steps loadSteps(const std::string& filename);
     void saveSteps(const std::string& filename) const;
@@ -23,4 +30,18 @@ public:
 
     bool isEmpty() const {return steps.empty();}
 
+    uint64_t getRandomSeed() const { return randomSeed; }
+    void setRandomSeed(uint64_t seed) { randomSeed = seed; }
+
+    void addStateHash(size_t iteration, uint64_t hash) { stateHashes.emplace_back(iteration, hash); }
+    const std::vector<std::pair<size_t, uint64_t>>& getStateHashes() const { return stateHashes; }
+
+    size_t getEndCycle() const { return endCycle; }
+    void setEndCycle(size_t cycle) { endCycle = cycle; }
+
+    void skipUntil(size_t iteration) {    // drops the steps of iterations that were already played
+        while (!steps.empty() && steps.front().first <= iteration)
+            steps.pop_front();
+    }
+
 };
\ No newline at end of file
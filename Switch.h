@@ -1,31 +1,33 @@
 #pragma once
 #include "Point.h"
+#include "Zobrist.h"
 
 class Switch
 {
 private:
 	Point pos;         // Position of the switch on the board  
-	int doorID;        // The door this switch is linked to
+	int8_t doorID;     // The door this switch is linked to
 	bool state;        // True = ON, False = OFF
-	char figure;       // Character drawn on screen ('/' or 'o')
 
 public:
-	Switch(): pos(0, 0), doorID(-1), state(false),figure('o')     // default ctor 
+	Switch(): pos(0, 0), doorID(-1), state(false)     // default ctor 
 	{
 	}
 	Switch(Point _pos, int _doorID, bool _state)      // custom ctor     
-		: pos(_pos), doorID(_doorID), state(_state)
+		: pos(_pos), doorID(static_cast<int8_t>(_doorID)), state(_state)
 	{
-		figure = _state ? '/' : 'o';
 	}
 
-	void setDoorId(int id) { doorID = id; }
+	void setDoorId(int id) { doorID = static_cast<int8_t>(id); }
 
 	// Get Functions
 	Point getPos() const { return pos; }
 	int getDoorID() const { return doorID; }
 	bool getState() const { return state; }
-	char getFigure() const { return state ? '/' : 'o'; }\
+	char getFigure() const { return state ? BOARD_SWITCH_ON : BOARD_SWITCH_OFF; }   // Character drawn on screen ('/' or 'o')
+	uint64_t hashKey() const {   // Zobrist key of this record
+		return Zobrist::key(Zobrist::SWITCH, Zobrist::pack(pos), static_cast<uint8_t>(doorID) | (state << 8));
+	}
 
 	void toggle()  // Toggles the switch state. If it was ON, it becomes OFF, and vice versa
 	{
@@ -1,4 +1,7 @@
 #pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 //learned by ourselves when saw too much duplicates of the same funcs
 template <typename T> //means the next func isn't a reg func, it's a template
@@ -9,6 +12,34 @@ T* getItemAt(std::vector<T>& list, const Point& p) { //'T' is deduced automatica
 	return nullptr; //item wasn't found
 }
 
+// Item held in a player's inventory (collected items stay in the list, inactive).
+// Found by its id - removals reorder the list, so a position in it isn't kept
+template <typename T>
+T* getStoredItem(std::vector<T>& list, int id) {
+	for (auto& item : list) {
+		if (!item.isActive() && item.getId() == id) return &item;
+	}
+	return nullptr;
+}
+
+template <typename T>
+const T* getStoredItem(const std::vector<T>& list, int id) {
+	for (const auto& item : list) {
+		if (!item.isActive() && item.getId() == id) return &item;
+	}
+	return nullptr;
+}
+
+// Next free id of a list of collectable items
+template <typename T>
+int nextItemId(const std::vector<T>& list) {
+	int id = 0;
+	for (const auto& item : list) {
+		if (item.getId() >= id) id = item.getId() + 1;
+	}
+	return id;
+}
+
 template <typename T>
 // delete template func using iterator for going through the vector list
 bool removeItemAt(std::vector<T>& list, const Point& p) {
@@ -21,3 +52,54 @@ bool removeItemAt(std::vector<T>& list, const Point& p) {
 	}
 	return false;
 }
+
+// Vector with inline storage for the first N elements - only spills to the heap
+// when an object grows past N (used for obstacle bodies, which are almost always small)
+template <typename T, int N>
+class SmallVector {
+private:
+	T inlineItems[N];
+	std::vector<T> spill;     // holds all elements once size > N
+	int count = 0;
+
+	bool spilled() const { return !spill.empty(); }
+
+public:
+	SmallVector() = default;
+	SmallVector(const std::vector<T>& items) {
+		for (const T& item : items) push_back(item);
+	}
+
+	T* begin() { return spilled() ? spill.data() : inlineItems; }
+	T* end() { return begin() + count; }
+	const T* begin() const { return spilled() ? spill.data() : inlineItems; }
+	const T* end() const { return begin() + count; }
+
+	T& operator[](std::size_t i) { return begin()[i]; }
+	const T& operator[](std::size_t i) const { return begin()[i]; }
+	std::size_t size() const { return static_cast<std::size_t>(count); }
+	bool empty() const { return count == 0; }
+	std::size_t heapBytes() const { return spill.capacity() * sizeof(T); }
+
+	void push_back(const T& item) {
+		if (!spilled() && count < N) {
+			inlineItems[count++] = item;
+			return;
+		}
+		if (!spilled())
+			spill.assign(inlineItems, inlineItems + count);   // first overflow - move everything to the heap
+		spill.push_back(item);
+		count++;
+	}
+
+	void erase(T* it) {
+		if (spilled()) {
+			spill.erase(spill.begin() + (it - spill.data()));
+		}
+		else {
+			for (T* p = it; p + 1 < end(); ++p)
+				*p = *(p + 1);
+		}
+		count--;
+	}
+};
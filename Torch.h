@@ -1,26 +1,31 @@
 #pragma once
 #include "Point.h"
+#include "Zobrist.h"
 
 class Torch{
 private:
 	Point pos;          // Position on the board
-	char figure = '!';
 	bool active;        // True if torch is on board
+	uint8_t spare;      // Unused, always 0 - every byte of the record is defined (raw state files)
+	uint16_t id;        // Stable within the room's torch list - what a player holding it remembers
 
 public:
-	Torch() : pos(0, 0), figure('!'), active(false)   // default ctor 
+	Torch() : pos(0, 0), active(false), spare(0), id(0)   // default ctor 
 	{
 	}
 	Torch(Point _pos)                // custom ctor 
-		: pos(_pos), active(true)
+		: pos(_pos), active(true), spare(0), id(0)
 	{
 	}
 
 	// Get Functions
 	Point getPos() const { return pos; }
-	char getFigure() const { return figure; }
+	char getFigure() const { return BOARD_TORCH; }
 	bool isActive() const { return active; }
+	int getId() const { return id; }
+	void setId(int _id) { id = static_cast<uint16_t>(_id); }
 	void setPos(Point pos) { this->pos = pos; }
+	uint64_t hashKey() const { return Zobrist::key(Zobrist::TORCH, Zobrist::pack(pos), active); }   // Zobrist key of this record
 
 	void activate() { active = true; }          // Marks the torch as available (visible on screen).
 	void deactivate() { active = false; }       // Marks the torch as collected (no longer visible).
@@ -58,6 +58,11 @@ std::string Utils::toUpperCase(std::string str) {
 	return str;
 }
 
+void Utils::delay(int ms) {
+	if (ms > 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
 void Utils::hideCursor() {
 #ifdef _WIN32
 	HANDLE myconsole = GetStdHandle(STD_OUTPUT_HANDLE);
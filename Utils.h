@@ -34,3 +34,4 @@ namespace Utils {
 
 constexpr int SCREEN_WIDTH = 80;
 constexpr int SCREEN_HEIGHT = 25;
+constexpr int BOARD_CELLS = SCREEN_WIDTH * SCREEN_HEIGHT;
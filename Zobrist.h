@@ -0,0 +1,37 @@
+#pragma once
+#include "Point.h"
+
+// File: Zobrist.h
+// Description:
+//   Keys for the 64-bit Zobrist hash of the game state.
+//   Every feature (board cell, object record, player field) gets a pseudo-random key,
+//   and a state's hash is the XOR of the keys of everything in it - so a change is
+//   applied by XOR-ing the old key out and the new key in.
+//   Keys are computed on the fly (SplitMix64 finalizer) instead of stored in tables.
+
+namespace Zobrist {
+
+    enum Feature : uint64_t { CELL = 1, KEY, BOMB, TORCH, DOOR, SWITCH, SPRING, RIDDLE, OBSTACLE, PLAYER, ROOM, GAME };
+
+    inline uint64_t mix(uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Folds another field into a running key
+    inline uint64_t combine(uint64_t h, uint64_t value) { return mix(h ^ value); }
+
+    inline uint64_t pack(const Point& p) {
+        return static_cast<uint8_t>(p.getX()) | (static_cast<uint64_t>(static_cast<uint8_t>(p.getY())) << 8);
+    }
+
+    inline uint64_t key(Feature f, uint64_t a, uint64_t b = 0) {
+        return combine(mix((static_cast<uint64_t>(f) << 56) ^ a), b);
+    }
+
+    inline uint64_t cell(const Point& p, char c) {
+        return key(CELL, pack(p), static_cast<uint8_t>(c));
+    }
+}